@@ -40,6 +40,16 @@ namespace IL2CXX.Tests
             Array.Copy(xs, 1, ys, 2, 3);
             return AssertEquals(ys, new[] { null, null, "World", "Good", "Bye", null });
         }
+        static int CopyOverlapping()
+        {
+            var xs = new string[6];
+            for (var i = 0; i < 4; ++i) xs[i] = new string((char)('a' + i), 2);
+            Array.Copy(xs, 0, xs, 2, 4);
+            Array.Copy(xs, 3, xs, 1, 3);
+            GC.Collect();
+            GC.WaitForPendingFinalizers();
+            return AssertEquals(xs, new[] { "aa", "bb", "cc", "dd", "cc", "dd" });
+        }
         static int ResizeLarger()
         {
             string[] xs = { "Hello", "World", "Good", "Bye" };
@@ -118,6 +128,31 @@ namespace IL2CXX.Tests
         }
         static int New1() => AssertEquals(new string[1], new string[] { null });
         static int New2() => (new string[1, 1])[0, 0] == null ? 0 : 1;
+        static unsafe int Aligned()
+        {
+            var xs = new byte[3];
+            var ys = new double[2, 3];
+            fixed (byte* p = xs)
+            fixed (double* q = ys)
+                return (long)p % 16 == 0 && (long)q % 16 == 0 ? 0 : 1;
+        }
+        static int AllocateArray()
+        {
+            var xs = GC.AllocateArray<byte>(65536, true);
+            foreach (var x in xs) if (x != 0) return 1;
+            var ys = GC.AllocateUninitializedArray<byte>(65536);
+            return ys.Length == 65536 ? 0 : 2;
+        }
+        static unsafe int AllocatePinned()
+        {
+            var xs = GC.AllocateArray<byte>(4096, true);
+            long p0;
+            fixed (byte* p = xs) p0 = (long)p;
+            for (var i = 0; i < 1000; ++i) _ = new byte[4096];
+            GC.Collect();
+            GC.WaitForPendingFinalizers();
+            fixed (byte* p = xs) return (long)p == p0 ? 0 : 1;
+        }
 
         static int Run(string[] arguments) => arguments[1] switch
         {
@@ -125,6 +160,7 @@ namespace IL2CXX.Tests
             nameof(Clear) => Clear(),
             nameof(ClearAll) => ClearAll(),
             nameof(Copy) => Copy(),
+            nameof(CopyOverlapping) => CopyOverlapping(),
             nameof(ResizeLarger) => ResizeLarger(),
             nameof(ResizeSmaller) => ResizeSmaller(),
             nameof(IListIsReadOnly) => IListIsReadOnly(),
@@ -140,6 +176,9 @@ namespace IL2CXX.Tests
             nameof(ReverseT) => ReverseT(),
             nameof(New1) => New1(),
             nameof(New2) => New2(),
+            nameof(Aligned) => Aligned(),
+            nameof(AllocateArray) => AllocateArray(),
+            nameof(AllocatePinned) => AllocatePinned(),
             _ => -1
         };
 
@@ -154,6 +193,7 @@ namespace IL2CXX.Tests
                 nameof(Clear),
                 nameof(ClearAll),
                 nameof(Copy),
+                nameof(CopyOverlapping),
                 nameof(ResizeLarger),
                 nameof(ResizeSmaller),
                 nameof(IListIsReadOnly),
@@ -168,7 +208,10 @@ namespace IL2CXX.Tests
                 nameof(Reverse),
                 nameof(ReverseT),
                 nameof(New1),
-                nameof(New2)
+                nameof(New2),
+                nameof(Aligned),
+                nameof(AllocateArray),
+                nameof(AllocatePinned)
             )] string name,
             [Values] bool cooperative
         ) => Utilities.Run(build, cooperative, name);
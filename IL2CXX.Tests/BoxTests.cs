@@ -26,6 +26,20 @@ namespace IL2CXX.Tests
         static int BoxObjectUnboxNullable() => BoxUnbox<object, int?>(1) == 1 ? 0 : 1;
         static int BoxValueUnboxAssignable() => BoxUnbox<int, IComparable>(1) != null ? 0 : 1;
         static int BoxObjectUnboxAssignable() => BoxUnbox<string, IComparable>(string.Empty) != null ? 0 : 1;
+        enum Bar : short { X = -1, Y = 2 }
+        static int ConstrainedHashCode<T>(T x) => x.GetHashCode();
+        static bool ConstrainedEquals<T>(T x, object y) => x.Equals(y);
+        static int ConstrainedEnumGetHashCode() => ConstrainedHashCode(Bar.Y) == ((object)Bar.Y).GetHashCode() && ConstrainedHashCode(Bar.X) == ((object)Bar.X).GetHashCode() ? 0 : 1;
+        static int ConstrainedEnumEquals() => ConstrainedEquals(Bar.Y, Bar.Y) && !ConstrainedEquals(Bar.Y, Bar.X) && !ConstrainedEquals(Bar.Y, (short)2) ? 0 : 1;
+        static int BoxSmall()
+        {
+            if (Box(5) != Box(5) || Box(true) != Box(true) || Box(Bar.X) != Box(Bar.X)) return 1;
+            foreach (var x in new[] { -129, -128, -1, 0, 1023, 1024 })
+                if ((int)Box(x) != x || (long)Box((long)x) != x) return 2;
+            if ((uint)Box(uint.MaxValue) != uint.MaxValue || (ulong)Box(ulong.MaxValue) != ulong.MaxValue) return 3;
+            if ((bool)Box(false) || !(bool)Box(true) || (char)Box('A') != 'A') return 4;
+            return (Bar)Box(Bar.Y) == Bar.Y ? 0 : 5;
+        }
 
         static int Run(string[] arguments) => arguments[1] switch
         {
@@ -45,6 +59,9 @@ namespace IL2CXX.Tests
             nameof(BoxObjectUnboxNullable) => BoxObjectUnboxNullable(),
             nameof(BoxValueUnboxAssignable) => BoxValueUnboxAssignable(),
             nameof(BoxObjectUnboxAssignable) => BoxObjectUnboxAssignable(),
+            nameof(ConstrainedEnumGetHashCode) => ConstrainedEnumGetHashCode(),
+            nameof(ConstrainedEnumEquals) => ConstrainedEnumEquals(),
+            nameof(BoxSmall) => BoxSmall(),
             _ => -1
         };
 
@@ -70,7 +87,10 @@ namespace IL2CXX.Tests
                 nameof(BoxNullUnboxNullable),
                 nameof(BoxObjectUnboxNullable),
                 nameof(BoxValueUnboxAssignable),
-                nameof(BoxObjectUnboxAssignable)
+                nameof(BoxObjectUnboxAssignable),
+                nameof(ConstrainedEnumGetHashCode),
+                nameof(ConstrainedEnumEquals),
+                nameof(BoxSmall)
             )] string name,
             [Values] bool cooperative
         ) => Utilities.Run(build, cooperative, name);
@@ -145,6 +145,38 @@ namespace IL2CXX.Tests
             return trim.Target is string x && x == " Hello " ? 0 : 1;
         }
 
+        class Baz
+        {
+            public string First = "Hello";
+            public string Second;
+            public object Third;
+
+            public Baz(string value)
+            {
+                Second = value;
+                First = $"{First}, {value}!";
+                Third = this;
+            }
+        }
+        static int Construct()
+        {
+            var x = new Baz("World");
+            GC.Collect();
+            GC.WaitForPendingFinalizers();
+            Console.WriteLine(x.First);
+            return x.First == "Hello, World!" && x.Second == "World" && x.Third == x ? 0 : 1;
+        }
+        static int IdentityHash()
+        {
+            var xs = new object[256];
+            for (var i = 0; i < xs.Length; ++i) xs[i] = new object();
+            if (System.Runtime.CompilerServices.RuntimeHelpers.GetHashCode(null) != 0) return 1;
+            if (xs[0].GetHashCode() != xs[0].GetHashCode()) return 2;
+            var buckets = new bool[16];
+            foreach (var x in xs) buckets[x.GetHashCode() & 15] = true;
+            return Array.TrueForAll(buckets, x => x) ? 0 : 3;
+        }
+
         static int Run(string[] arguments) => arguments[1] switch
         {
             nameof(CallVirtual) => CallVirtual(),
@@ -159,6 +191,8 @@ namespace IL2CXX.Tests
             nameof(Event) => Event(),
             nameof(Static) => Static(),
             nameof(Target) => Target(),
+            nameof(Construct) => Construct(),
+            nameof(IdentityHash) => IdentityHash(),
             _ => -1
         };
 
@@ -180,7 +214,9 @@ namespace IL2CXX.Tests
                 nameof(CallInterfaceGeneric),
                 nameof(Event),
                 nameof(Static),
-                nameof(Target)
+                nameof(Target),
+                nameof(Construct),
+                nameof(IdentityHash)
             )] string name,
             [Values] bool cooperative
         ) => Utilities.Run(build, cooperative, name);
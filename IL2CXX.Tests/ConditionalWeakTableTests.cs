@@ -16,8 +16,9 @@ namespace IL2CXX.Tests
             string y = null;
             WithPadding(() =>
             {
-                x = "Hello";
-                y = "World";
+                // Literals are interned for the lifetime of the process.
+                x = new string("Hello".AsSpan());
+                y = new string("World".AsSpan());
                 table.Add(x, y);
             });
             if (WithPadding(() => !table.TryGetValue(x, out var z) || z != y)) return 1;
@@ -75,6 +76,23 @@ namespace IL2CXX.Tests
             if (table.Remove(x)) return 2;
             return table.TryGetValue(x, out _) ? 3 : 0;
         }
+        class Bar
+        {
+            public object Key;
+        }
+        static int ValueReferencesKey()
+        {
+            var table = new ConditionalWeakTable<object, Bar>();
+            var (wx, wy) = WithPadding(() =>
+            {
+                var x = new object();
+                var y = new Bar { Key = x };
+                table.Add(x, y);
+                return (new WeakReference<object>(x), new WeakReference<Bar>(y));
+            });
+            GC.Collect();
+            return wx.TryGetTarget(out _) || wy.TryGetTarget(out _) ? 1 : 0;
+        }
 
         static int Run(string[] arguments) => arguments[1] switch
         {
@@ -84,6 +102,7 @@ namespace IL2CXX.Tests
             nameof(GetOrCreateValue) => GetOrCreateValue(),
             nameof(GetValue) => GetValue(),
             nameof(Remove) => Remove(),
+            nameof(ValueReferencesKey) => ValueReferencesKey(),
             _ => -1
         };
 
@@ -99,7 +118,8 @@ namespace IL2CXX.Tests
                 nameof(Clear),
                 nameof(GetOrCreateValue),
                 nameof(GetValue),
-                nameof(Remove)
+                nameof(Remove),
+                nameof(ValueReferencesKey)
             )] string name,
             [Values] bool cooperative
         ) => Utilities.Run(build, cooperative, name);
@@ -14,7 +14,8 @@ namespace IL2CXX.Tests
             object x = null;
             using var handle = WithPadding(() =>
             {
-                x = "Hello";
+                // Literals are interned for the lifetime of the process.
+                x = new string("Hello".AsSpan());
                 return new DependentHandle(x, "World");
             });
             if (!WithPadding(() =>
@@ -0,0 +1,122 @@
+using System;
+using System.IO;
+using System.Linq;
+using System.Runtime.InteropServices;
+using System.Threading;
+using NUnit.Framework;
+
+namespace IL2CXX.Tests
+{
+    [Parallelizable]
+    class DiagnosticsTests
+    {
+        class Foo
+        {
+        }
+        class Cycle
+        {
+            public Cycle Next;
+        }
+        static int Trace()
+        {
+            for (var i = 0; i < 1000; ++i) _ = new Foo();
+            for (var i = 0; i < 1000; ++i)
+            {
+                var x = new Cycle();
+                x.Next = x;
+            }
+            GC.Collect();
+            return 0;
+        }
+        static Foo[] foos;
+        [DllImport("libc")]
+        static extern int getpid();
+        [DllImport("libc")]
+        static extern int kill(int pid, int signal);
+        [DllImport("libc")]
+        static extern int __libc_current_sigrtmin();
+        static int Census()
+        {
+            foos = new Foo[100];
+            for (var i = 0; i < foos.Length; ++i) foos[i] = new Foo();
+            var t = new Thread(() =>
+            {
+                for (var i = 0; i < 10000; ++i) _ = new object();
+            });
+            t.Start();
+            GC.Collect();
+            t.Join();
+            // Ask for a dump while running, as t__census::f_signal() does.
+            if (kill(getpid(), __libc_current_sigrtmin() + 4) != 0) return 1;
+            var path = Environment.GetEnvironmentVariable("IL2CXX_CENSUS");
+            for (var i = 0; i < 100; ++i)
+            {
+                if (File.Exists(path) && File.ReadAllText(path).Contains("DiagnosticsTests+Foo")) return 0;
+                Thread.Sleep(100);
+            }
+            return 2;
+        }
+        // Its name starts with hex digits, which the profile must not take for an escape.
+        static int Decode()
+        {
+            foos = new Foo[1000];
+            for (var i = 0; i < foos.Length; ++i) foos[i] = new Foo();
+            return 0;
+        }
+        static int AllocationProfile() => Decode();
+
+        static int Run(string[] arguments) => arguments[1] switch
+        {
+            nameof(Trace) => Trace(),
+            nameof(Census) => Census(),
+            nameof(AllocationProfile) => AllocationProfile(),
+            _ => -1
+        };
+
+        string build;
+
+        [OneTimeSetUp]
+        public void OneTimeSetUp() => build = Utilities.Build(Run);
+        [Test]
+        public void TestTrace([Values] bool cooperative)
+        {
+            var path = Path.Combine(build, $"trace-{cooperative}");
+            File.Delete(path);
+            Utilities.Run(build, cooperative, nameof(Trace), variables: new[] { ("IL2CXX_TRACE", path) });
+            var bytes = File.ReadAllBytes(path);
+            // Each event is 32 bytes of time, kind, thread, value and duration.
+            Assert.AreEqual(0, bytes.Length % 32);
+            var kinds = Enumerable.Range(0, bytes.Length / 32).Select(i => BitConverter.ToUInt32(bytes, i * 32 + 8)).ToHashSet();
+            // e_collect, e_released and e_cyclic_released.
+            Assert.IsTrue(kinds.Contains(0));
+            Assert.IsTrue(kinds.Contains(7));
+            Assert.IsTrue(kinds.Contains(8));
+        }
+        [Test]
+        public void TestCensus([Values] bool cooperative)
+        {
+            if (RuntimeInformation.IsOSPlatform(OSPlatform.Windows)) return;
+            var path = Path.Combine(build, $"census-{cooperative}");
+            File.Delete(path);
+            Utilities.Run(build, cooperative, nameof(Census), variables: new[] { ("IL2CXX_CENSUS", path) });
+            // One dump on the signal and another at exit, each with a line of live count, bytes and type name.
+            var dumps = File.ReadAllText(path).Split("# census", StringSplitOptions.RemoveEmptyEntries);
+            Assert.AreEqual(2, dumps.Length);
+            foreach (var x in dumps)
+                Assert.IsTrue(x.Split('\n').Select(y => y.Split('\t')).Any(y => y.Length == 3 && y[0] == "100" && y[2].StartsWith("IL2CXX.Tests.DiagnosticsTests+Foo,")));
+        }
+        [Test]
+        public void TestAllocationProfile([Values] bool cooperative)
+        {
+            if (RuntimeInformation.IsOSPlatform(OSPlatform.Windows)) return;
+            var path = Path.Combine(build, $"allocation-profile-{cooperative}");
+            File.Delete(path);
+            Utilities.Run(build, cooperative, nameof(AllocationProfile), variables: new[] {
+                ("IL2CXX_ALLOCATION_PROFILE", path),
+                ("IL2CXX_ALLOCATION_SAMPLE", "1")
+            });
+            // Collapsed stacks run from the outermost frame to the allocated type, each followed by its bytes.
+            Assert.IsTrue(File.ReadAllLines(path).Any(x => x.Contains(";IL2CXX.Tests.DiagnosticsTests::Decode;")));
+        }
+    }
+}
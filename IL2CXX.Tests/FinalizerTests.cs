@@ -1,4 +1,5 @@
 using System;
+using System.Threading;
 using NUnit.Framework;
 
 namespace IL2CXX.Tests
@@ -98,11 +99,30 @@ namespace IL2CXX.Tests
             return Bar.Finalized == 1 ? 0 : 2;
         }
 
+        class Qux
+        {
+            public static int Finalized;
+
+            ~Qux() => Interlocked.Increment(ref Finalized);
+        }
+        static int Many()
+        {
+            WithPadding(() =>
+            {
+                for (var i = 0; i < 10000; ++i) new Qux();
+            });
+            GC.Collect();
+            GC.WaitForPendingFinalizers();
+            Console.WriteLine($"finalized: {Qux.Finalized}");
+            return Qux.Finalized == 10000 ? 0 : 1;
+        }
+
         static int Run(string[] arguments) => arguments[1] switch
         {
             nameof(CollectAndWait) => CollectAndWait(),
             nameof(Suppress) => Suppress(),
             nameof(Resurrect) => Resurrect(),
+            nameof(Many) => Many(),
             _ => -1
         };
 
@@ -115,9 +135,19 @@ namespace IL2CXX.Tests
             [Values(
                 nameof(CollectAndWait),
                 nameof(Suppress),
-                nameof(Resurrect)
+                nameof(Resurrect),
+                nameof(Many)
             )] string name,
             [Values] bool cooperative
         ) => Utilities.Run(build, cooperative, name);
+        [Test]
+        public void TestThreads(
+            [Values(
+                nameof(CollectAndWait),
+                nameof(Resurrect),
+                nameof(Many)
+            )] string name,
+            [Values] bool cooperative
+        ) => Utilities.Run(build, cooperative, name, variables: new[] { ("IL2CXX_FINALIZER_THREADS", "4") });
     }
 }
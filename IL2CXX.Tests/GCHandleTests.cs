@@ -201,6 +201,31 @@ namespace IL2CXX.Tests
                 h.Free();
             }
         }
+        static int Many()
+        {
+            var xs = new object[1000];
+            var hs = new GCHandle[xs.Length];
+            for (var i = 0; i < xs.Length; ++i)
+            {
+                xs[i] = i.ToString();
+                hs[i] = GCHandle.Alloc(xs[i], i % 2 == 0 ? GCHandleType.Normal : GCHandleType.Weak);
+            }
+            try
+            {
+                for (var i = 0; i < xs.Length; ++i) if (hs[i].Target != xs[i]) return 1;
+                for (var i = 0; i < xs.Length; i += 3)
+                {
+                    hs[i].Free();
+                    hs[i] = GCHandle.Alloc(xs[i], GCHandleType.Weak);
+                }
+                for (var i = 0; i < xs.Length; ++i) if (hs[i].Target != xs[i]) return 2;
+                return 0;
+            }
+            finally
+            {
+                foreach (var h in hs) h.Free();
+            }
+        }
 
         static int Run(string[] arguments) => arguments[1] switch
         {
@@ -211,6 +236,7 @@ namespace IL2CXX.Tests
             nameof(Pinned) => Pinned(),
             nameof(IsAllocated) => IsAllocated(),
             nameof(IntPtr) => IntPtr(),
+            nameof(Many) => Many(),
             _ => -1
         };
 
@@ -227,7 +253,8 @@ namespace IL2CXX.Tests
                 nameof(Normal),
                 nameof(Pinned),
                 nameof(IsAllocated),
-                nameof(IntPtr)
+                nameof(IntPtr),
+                nameof(Many)
             )] string name,
             [Values] bool cooperative
         ) => Utilities.Run(build, cooperative, name);
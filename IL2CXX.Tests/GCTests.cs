@@ -0,0 +1,172 @@
+using System;
+using System.Collections.Generic;
+using System.Runtime;
+using System.Threading;
+using NUnit.Framework;
+
+namespace IL2CXX.Tests
+{
+    [Parallelizable]
+    class GCTests
+    {
+        static int TotalAllocatedBytes()
+        {
+            var n = GC.GetTotalAllocatedBytes(true);
+            for (var i = 0; i < 100; ++i) _ = new byte[1024];
+            return GC.GetTotalAllocatedBytes(true) - n >= 100 * 1024 ? 0 : 1;
+        }
+        static int TotalAllocatedBytesOfOtherThread()
+        {
+            var n = GC.GetTotalAllocatedBytes(true);
+            using var allocated = new ManualResetEventSlim();
+            using var done = new ManualResetEventSlim();
+            var t = new Thread(() =>
+            {
+                _ = new byte[4096];
+                allocated.Set();
+                done.Wait();
+            });
+            t.Start();
+            allocated.Wait();
+            var m = GC.GetTotalAllocatedBytes(true);
+            done.Set();
+            t.Join();
+            return m - n >= 4096 ? 0 : 1;
+        }
+        static int AllocatedBytesForCurrentThread()
+        {
+            var n = GC.GetAllocatedBytesForCurrentThread();
+            _ = new byte[4096];
+            return GC.GetAllocatedBytesForCurrentThread() - n >= 4096 ? 0 : 1;
+        }
+        static int MemoryInfo()
+        {
+            var info = GC.GetGCMemoryInfo();
+            Console.WriteLine($"total: {info.TotalAvailableMemoryBytes}, load: {info.MemoryLoadBytes}, heap: {info.HeapSizeBytes}");
+            if (info.TotalAvailableMemoryBytes <= 0) return 1;
+            if (info.HighMemoryLoadThresholdBytes > info.TotalAvailableMemoryBytes) return 2;
+            if (info.MemoryLoadBytes > info.TotalAvailableMemoryBytes) return 3;
+            // The managed heap is part of what the process has committed.
+            return info.HeapSizeBytes > 0 && info.HeapSizeBytes <= info.TotalCommittedBytes ? 0 : 4;
+        }
+        static int LatencyMode()
+        {
+            if (GCSettings.LatencyMode != GCLatencyMode.Interactive) return 1;
+            GCSettings.LatencyMode = GCLatencyMode.SustainedLowLatency;
+            if (GCSettings.LatencyMode != GCLatencyMode.SustainedLowLatency) return 2;
+            GCSettings.LatencyMode = GCLatencyMode.Interactive;
+            return GCSettings.LatencyMode == GCLatencyMode.Interactive ? 0 : 3;
+        }
+        static int NoGCRegion()
+        {
+            if (!GC.TryStartNoGCRegion(1024 * 1024)) return 1;
+            if (GCSettings.LatencyMode != GCLatencyMode.NoGCRegion) return 2;
+            _ = new byte[1024];
+            GC.EndNoGCRegion();
+            return GCSettings.LatencyMode == GCLatencyMode.Interactive ? 0 : 3;
+        }
+        static int NoGCRegionExceeded()
+        {
+            if (!GC.TryStartNoGCRegion(1024 * 1024)) return 1;
+            for (var i = 0; i < 64; ++i) _ = new byte[64 * 1024];
+            // Going over the budget has left the region already.
+            if (GCSettings.LatencyMode != GCLatencyMode.Interactive) return 2;
+            try
+            {
+                GC.EndNoGCRegion();
+                return 3;
+            }
+            catch (InvalidOperationException)
+            {
+                return 0;
+            }
+        }
+        class Cyclic
+        {
+            public Cyclic Self;
+        }
+        static int MemoryPressure()
+        {
+            // Removing the pressure has to lower the trigger too, or none of the steps below would reach it again.
+            GC.AddMemoryPressure(1L << 40);
+            GC.RemoveMemoryPressure(1L << 40);
+            // A cycle is only reclaimed by cycle collection, so it outlives its last reference until the pressure requests some.
+            var w = Utilities.WithPadding(() =>
+            {
+                var x = new Cyclic();
+                x.Self = x;
+                return new WeakReference(x);
+            });
+            // Adding 4MB from none is always enough to request a collection, and removing it lets the next step request another.
+            // The collector runs on its own thread, so give it up to 30 seconds on a loaded machine.
+            for (var i = 0; i < 3000; ++i)
+            {
+                GC.AddMemoryPressure(4L << 20);
+                GC.RemoveMemoryPressure(4L << 20);
+                if (!w.IsAlive) return 0;
+                Thread.Sleep(10);
+            }
+            return 1;
+        }
+        static int HeapHardLimit()
+        {
+            var arrays = new List<byte[]>();
+            try
+            {
+                while (arrays.Count < 1 << 16) arrays.Add(new byte[64 << 10]);
+                return 1;
+            }
+            catch (OutOfMemoryException)
+            {
+                Console.WriteLine($"out of memory after {arrays.Count} arrays");
+            }
+            // Once the arrays are gone, the heap has room again.
+            arrays.Clear();
+            GC.Collect();
+            for (var i = 0; i < 16; ++i) arrays.Add(new byte[64 << 10]);
+            return 0;
+        }
+        static int ProcessorCount()
+        {
+            Console.WriteLine($"processors: {Environment.ProcessorCount}");
+            return Environment.ProcessorCount > 0 ? 0 : 1;
+        }
+
+        static int Run(string[] arguments) => arguments[1] switch
+        {
+            nameof(TotalAllocatedBytes) => TotalAllocatedBytes(),
+            nameof(TotalAllocatedBytesOfOtherThread) => TotalAllocatedBytesOfOtherThread(),
+            nameof(AllocatedBytesForCurrentThread) => AllocatedBytesForCurrentThread(),
+            nameof(MemoryInfo) => MemoryInfo(),
+            nameof(LatencyMode) => LatencyMode(),
+            nameof(NoGCRegion) => NoGCRegion(),
+            nameof(NoGCRegionExceeded) => NoGCRegionExceeded(),
+            nameof(MemoryPressure) => MemoryPressure(),
+            nameof(HeapHardLimit) => HeapHardLimit(),
+            nameof(ProcessorCount) => ProcessorCount(),
+            _ => -1
+        };
+
+        string build;
+
+        [OneTimeSetUp]
+        public void OneTimeSetUp() => build = Utilities.Build(Run);
+        [Test]
+        public void Test(
+            [Values(
+                nameof(TotalAllocatedBytes),
+                nameof(TotalAllocatedBytesOfOtherThread),
+                nameof(AllocatedBytesForCurrentThread),
+                nameof(MemoryInfo),
+                nameof(LatencyMode),
+                nameof(NoGCRegion),
+                nameof(NoGCRegionExceeded),
+                nameof(MemoryPressure),
+                nameof(ProcessorCount)
+            )] string name,
+            [Values] bool cooperative
+        ) => Utilities.Run(build, cooperative, name);
+        [Test]
+        public void TestHeapHardLimit([Values] bool cooperative) => Utilities.Run(build, cooperative, nameof(HeapHardLimit), variables: new[] { ("IL2CXX_GC_HEAP_HARD_LIMIT", $"{64 << 20}") });
+    }
+}
@@ -101,6 +101,14 @@ namespace IL2CXX.Tests
             }
             return 0;
         }
+        static int SinglePrecision()
+        {
+            float cancel(float x, float y) => x + y - x;
+            if (cancel(16777216f, 1f) != 0f) return 1;
+            float rem(float x, float y) => x % y;
+            if (rem(5.5f, 2f) != 1.5f) return 2;
+            return 0;
+        }
         static int Unordered()
         {
             int ne(float x, float y) => x != y ? 1 : 0;
@@ -152,6 +160,7 @@ namespace IL2CXX.Tests
             nameof(CheckedCastUnsigned) => CheckedCastUnsigned(),
             nameof(Single) => Single(),
             nameof(Double) => Double(),
+            nameof(SinglePrecision) => SinglePrecision(),
             nameof(Unordered) => Unordered(),
             nameof(ToInt32) => ToInt32(),
             nameof(ToPointer) => ToPointer(),
@@ -179,6 +188,7 @@ namespace IL2CXX.Tests
                 nameof(CheckedCastUnsigned),
                 nameof(Single),
                 nameof(Double),
+                nameof(SinglePrecision),
                 nameof(Unordered),
                 nameof(ToInt32),
                 nameof(ToPointer),
@@ -23,6 +23,11 @@ namespace IL2CXX.Tests
             string f(object x, object y) => $"Hello, {x} and {y}!";
             return AssertEquals(f("World", 0), "Hello, World and 0!");
         }
+        static int Literal()
+        {
+            static string f() => "Hello, World!";
+            return (object)f() == "Hello, World!" ? 0 : 1;
+        }
         static int IsNormalized() => "abc".IsNormalized() ? 0 : 1;
         static int Join() => AssertEquals(string.Join("/", 0, 1), "0/1");
         static int Split()
@@ -39,6 +44,7 @@ namespace IL2CXX.Tests
             nameof(Concatenation) => Concatenation(),
             nameof(EqualsIgnoreCase) => EqualsIgnoreCase(),
             nameof(Format) => Format(),
+            nameof(Literal) => Literal(),
             nameof(IsNormalized) => IsNormalized(),
             nameof(Join) => Join(),
             nameof(Split) => Split(),
@@ -58,6 +64,7 @@ namespace IL2CXX.Tests
                 nameof(Concatenation),
                 nameof(EqualsIgnoreCase),
                 nameof(Format),
+                nameof(Literal),
                 nameof(IsNormalized),
                 nameof(Join),
                 nameof(Split),
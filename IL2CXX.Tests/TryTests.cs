@@ -38,11 +38,45 @@ namespace IL2CXX.Tests
                 return 2;
             }
         }
+        class Foo
+        {
+            public string Value;
+        }
+        static int LiveAcrossCatch()
+        {
+            var x = new Foo { Value = new string('x', 3) };
+            try
+            {
+                GC.Collect();
+                throw new Exception("foo");
+            }
+            catch (Exception)
+            {
+                GC.Collect();
+                return x.Value == "xxx" ? 0 : 1;
+            }
+        }
+        static int LiveAcrossFinally()
+        {
+            var x = new Foo { Value = new string('x', 3) };
+            try
+            {
+                GC.Collect();
+            }
+            finally
+            {
+                GC.Collect();
+            }
+            GC.Collect();
+            return x.Value == "xxx" ? 0 : 1;
+        }
 
         static int Run(string[] arguments) => arguments[1] switch
         {
             nameof(Catch) => Catch(),
             nameof(Filter) => Filter(),
+            nameof(LiveAcrossCatch) => LiveAcrossCatch(),
+            nameof(LiveAcrossFinally) => LiveAcrossFinally(),
             _ => -1
         };
 
@@ -54,7 +88,9 @@ namespace IL2CXX.Tests
         public void Test(
             [Values(
                 nameof(Catch),
-                nameof(Filter)
+                nameof(Filter),
+                nameof(LiveAcrossCatch),
+                nameof(LiveAcrossFinally)
             )] string name,
             [Values] bool cooperative
         ) => Utilities.Run(build, cooperative, name);
@@ -105,6 +105,9 @@ function(add name)
 {'\t'}target_compile_options(${{name}} PRIVATE $<$<CXX_COMPILER_ID:MSVC>:/bigobj>)
 {'\t'}target_link_libraries(${{name}} recyclone $<$<NOT:$<PLATFORM_ID:Windows>>:dl>)
 {'\t'}target_precompile_headers(${{name}} PRIVATE declarations.h)
+{'\t'}if(NOT WIN32)
+{'\t'}{'\t'}set_target_properties(${{name}} PROPERTIES ENABLE_EXPORTS ON)
+{'\t'}endif()
 endfunction()
 add(run)
 add(runco)
@@ -117,13 +120,14 @@ target_compile_definitions(runco PRIVATE RECYCLONE__COOPERATIVE)
         }
         public static string Build(Func<int> method, IEnumerable<Type> bundle = null, IEnumerable<Type> generateReflection = null, IEnumerable<MethodInfo> bundleMethods = null) => Build(method.Method, bundle, generateReflection, bundleMethods);
         public static string Build(Func<string[], int> method, IEnumerable<Type> bundle = null, IEnumerable<Type> generateReflection = null, IEnumerable<MethodInfo> bundleMethods = null) => Build(method.Method, bundle, generateReflection, bundleMethods);
-        public static void Run(string build, bool cooperative, string arguments, bool verify = true)
+        public static void Run(string build, bool cooperative, string arguments, bool verify = true, IEnumerable<(string, string)> variables = null)
         {
             IEnumerable<(string, string)> environment = new[]
             {
                 ("IL2CXX_VERBOSE", string.Empty),
             };
             if (verify) environment = environment.Append(("IL2CXX_VERIFY_LEAKS", string.Empty));
+            if (variables != null) environment = environment.Concat(variables);
             var name = cooperative ? "runco" : "run";
             var path = Path.Combine(build, name);
             if (!File.Exists(path)) path = Path.Combine(build, "Debug", name);
@@ -18,19 +18,19 @@ namespace IL2CXX
         {
             code.For(
                 type.GetMethod("InternalAlloc", BindingFlags.Static | BindingFlags.NonPublic),
-                transpiler => ($"\treturn {transpiler.EscapeForValue(get(typeof(IntPtr)))}{{a_1 < 2 ? static_cast<t__handle*>(new t__weak_handle(a_0, a_1)) : new t__normal_handle(a_0)}};\n", 1)
+                transpiler => ($"\treturn {transpiler.EscapeForValue(get(typeof(IntPtr)))}{{t__handles::f_allocate(a_0, a_1)}};\n", 1)
             );
             code.For(
                 type.GetMethod("InternalFree", BindingFlags.Static | BindingFlags.NonPublic),
-                transpiler => ("\tdelete static_cast<t__handle*>(a_0.v__5fvalue);\n", 1)
+                transpiler => ("\tt__handles::f_free(a_0.v__5fvalue);\n", 1)
             );
             code.For(
                 type.GetMethod("InternalGet", BindingFlags.Static | BindingFlags.NonPublic),
-                transpiler => ("\treturn static_cast<t__handle*>(a_0.v__5fvalue)->f_target();\n", 1)
+                transpiler => ("\treturn t__handles::f_target(a_0.v__5fvalue);\n", 1)
             );
             code.For(
                 type.GetMethod("InternalSet", BindingFlags.Static | BindingFlags.NonPublic),
-                transpiler => ("\tstatic_cast<t__handle*>(a_0.v__5fvalue)->f_target__(a_1);\n", 1)
+                transpiler => ("\tt__handles::f_target__(a_0.v__5fvalue, a_1);\n", 1)
             );
         })
         .For(get(typeof(GCSettings)), (type, code) =>
@@ -39,10 +39,6 @@ namespace IL2CXX
                 type.GetProperty(nameof(GCSettings.IsServerGC)).GetMethod,
                 transpiler => ("\treturn false;\n", 1)
             );
-            code.For(
-                type.GetProperty(nameof(GCSettings.LatencyMode)).GetMethod,
-                transpiler => ("\treturn 1;\n", 1)
-            );
         })
         .For(get(typeof(Marshal)), (type, code) =>
         {
@@ -138,7 +134,7 @@ namespace IL2CXX
         {
             code.For(
                 type.GetMethod(nameof(GetHashCode), BindingFlags.Static | BindingFlags.Public),
-                transpiler => ("\treturn reinterpret_cast<intptr_t>(static_cast<t__object*>(a_0));\n", 0)
+                transpiler => ("\treturn a_0 ? f__identity_hash(static_cast<t__object*>(a_0)) : 0;\n", 1)
             );
             code.For(
                 type.GetMethod(nameof(RuntimeHelpers.GetUninitializedObject)),
@@ -194,7 +190,7 @@ namespace IL2CXX
         {
             code.For(
                 type.GetMethod("InternalInitialize", BindingFlags.Static | BindingFlags.NonPublic),
-                transpiler => ("\treturn new t__dependent_handle(a_0, a_1);\n", 1)
+                transpiler => ("\treturn t__handles::v_dependent.f_allocate(a_0, a_1);\n", 1)
             );
             code.For(
                 type.GetMethod("InternalGetTarget", BindingFlags.Static | BindingFlags.NonPublic),
@@ -221,7 +217,7 @@ namespace IL2CXX
             );
             code.For(
                 type.GetMethod("InternalFree", BindingFlags.Static | BindingFlags.NonPublic),
-                transpiler => ("\tdelete static_cast<t__dependent_handle*>(a_0.v__5fvalue);\n", 1)
+                transpiler => ("\tt__handles::v_dependent.f_free(static_cast<t__dependent_handle*>(a_0.v__5fvalue));\n", 1)
             );
         })
         .For(get(Type.GetType("System.Runtime.Intrinsics.Vector128`1", true)), (type, code) =>
@@ -307,12 +307,12 @@ namespace IL2CXX
         })
         .For(get(typeof(Array)), (type, code) =>
         {
-            code.Members = transpiler => ($@"{'\t'}struct t__bound
+            code.Members = transpiler => ($@"{'\t'}struct alignas(v__array_alignment) t__bound
 {'\t'}{{
 {'\t'}{'\t'}size_t v_length;
 {'\t'}{'\t'}int v_lower;
 {'\t'}}};
-{'\t'}size_t v__length;
+{'\t'}alignas(v__array_alignment) size_t v__length;
 {'\t'}t__bound* f_bounds()
 {'\t'}{{
 {'\t'}{'\t'}return reinterpret_cast<t__bound*>(this + 1);
@@ -537,20 +537,58 @@ namespace IL2CXX
         {
             code.For(
                 type.GetMethod("_Collect", BindingFlags.Static | BindingFlags.NonPublic),
-                transpiler => ($@"{'\t'}if (!(a_1 & 2)) {{
-{'\t'}{'\t'}f_engine()->f_tick();
-{'\t'}}} else if (a_1 & 4) {{
-{'\t'}{'\t'}f_engine()->f_wait();
-{'\t'}{'\t'}f_engine()->f_wait();
-{'\t'}{'\t'}if (uint32_t(a_0) > 1) {{
+                transpiler => ($@"{'\t'}if (f_engine()->v_no_gc.load(std::memory_order_relaxed)) f_engine()->v_no_gc__induced.store(true, std::memory_order_relaxed);
+{'\t'}t__trace::f_measure(t__trace_kind::e_collect, a_1, [&]
+{'\t'}{{
+{'\t'}{'\t'}if (!(a_1 & 2)) {{
+{'\t'}{'\t'}{'\t'}f_engine()->f_tick();
+{'\t'}{'\t'}}} else if (a_1 & 4) {{
 {'\t'}{'\t'}{'\t'}f_engine()->f_wait();
 {'\t'}{'\t'}{'\t'}f_engine()->f_wait();
+{'\t'}{'\t'}{'\t'}if (uint32_t(a_0) > 1) {{
+{'\t'}{'\t'}{'\t'}{'\t'}f_engine()->f_wait();
+{'\t'}{'\t'}{'\t'}{'\t'}f_engine()->f_wait();
+{'\t'}{'\t'}{'\t'}}}
+{'\t'}{'\t'}}} else {{
+{'\t'}{'\t'}{'\t'}f_engine()->f_collect();
 {'\t'}{'\t'}}}
-{'\t'}}} else {{
-{'\t'}{'\t'}f_engine()->f_collect();
-{'\t'}}}
+{'\t'}}});
 ", 0)
             );
+            code.For(
+                type.GetMethod("GetGCLatencyMode", BindingFlags.Static | BindingFlags.NonPublic),
+                transpiler => ("\treturn f_engine()->v_no_gc.load(std::memory_order_relaxed) ? 4 : f_engine()->v_latency_mode.load(std::memory_order_relaxed);\n", 1)
+            );
+            code.For(
+                type.GetMethod("SetGCLatencyMode", BindingFlags.Static | BindingFlags.NonPublic),
+                transpiler => ("\treturn f_engine()->f_latency_mode__(a_0);\n", 1)
+            );
+            code.For(
+                type.GetMethod("_StartNoGCRegion", BindingFlags.Static | BindingFlags.NonPublic),
+                transpiler => ("\treturn f_engine()->f_no_gc__start(a_0);\n", 1)
+            );
+            code.For(
+                type.GetMethod("_EndNoGCRegion", BindingFlags.Static | BindingFlags.NonPublic),
+                transpiler => ("\treturn f_engine()->f_no_gc__end();\n", 1)
+            );
+            code.For(
+                type.GetMethod("_AddMemoryPressure", BindingFlags.Static | BindingFlags.NonPublic),
+                transpiler => ("\tf_engine()->f_memory_pressure__add(a_0);\n", 1)
+            );
+            code.For(
+                type.GetMethod("_RemoveMemoryPressure", BindingFlags.Static | BindingFlags.NonPublic),
+                transpiler => ("\tf_engine()->f_memory_pressure__remove(a_0);\n", 1)
+            );
+            // GC.RefreshMemoryLimit reads GCHeapHardLimit from AppContext and passes it here, where the maximum means none.
+            if (type.GetMethod("_RefreshMemoryLimit", BindingFlags.Static | BindingFlags.NonPublic) is MethodInfo refresh)
+                code.For(
+                    refresh,
+                    transpiler =>
+                    {
+                        var limit = refresh.GetParameters()[0].ParameterType.GetField("HeapHardLimit", BindingFlags.Instance | BindingFlags.Public | BindingFlags.NonPublic);
+                        return ($"\treturn f_engine()->f_heap_limit__(a_0.{transpiler.Escape(limit)} == std::numeric_limits<uint64_t>::max() ? 0 : a_0.{transpiler.Escape(limit)});\n", 1);
+                    }
+                );
             code.For(
                 type.GetMethod(nameof(GC.SuppressFinalize)),
                 transpiler => (transpiler.GenerateCheckArgumentNull("a_0") + "\ta_0->f_type()->f_suppress_finalize(a_0);\n", 1)
@@ -561,38 +599,49 @@ namespace IL2CXX
             );
             code.For(
                 type.GetMethod(nameof(GC.WaitForPendingFinalizers)),
-                transpiler => ("\tf_engine()->f_finalize();\n", 1)
+                transpiler => ("\tt__trace::f_measure(t__trace_kind::e_finalize_wait, 0, [] { f_engine()->f_finalize__wait(); });\n", 1)
             );
+            // Objects never move, so GC_ALLOC_PINNED_OBJECT_HEAP needs no segment of its own.
             code.For(
                 type.GetMethod("AllocateNewArray", BindingFlags.Static | BindingFlags.NonPublic),
                 transpiler => ($@"{'\t'}return f__new_array(static_cast<t__type*>(static_cast<void*>(a_0))->v__element, a_1, [&](auto a_p, auto a_n)
 {'\t'}{{
-{'\t'}{'\t'}if (!a_2) std::memset(a_p, 0, a_n);
+{'\t'}{'\t'}// GC_ALLOC_ZEROING_OPTIONAL
+{'\t'}{'\t'}if (!(a_2 & 16)) std::memset(a_p, 0, a_n);
 {'\t'}}});
 ", 0)
             );
-            // TODO
+            // TODO: collection indices, pauses, promotions and fragmentation are not tracked by the collector.
             code.For(
                 type.GetMethod("GetMemoryInfo", BindingFlags.Static | BindingFlags.NonPublic),
-                transpiler => ($@"{'\t'}auto load = f_engine()->f_load_count();
-{'\t'}//a_0->... = load;
+                transpiler => ($@"{'\t'}auto total = t_engine::f_physical_memory();
+{'\t'}a_0->v__5fhighMemoryLoadThresholdBytes = total / 10 * 9;
+{'\t'}a_0->v__5ftotalAvailableMemoryBytes = total;
+{'\t'}a_0->v__5fmemoryLoadBytes = total - t_engine::f_available_memory();
+{'\t'}a_0->v__5fheapSizeBytes = f_engine()->f_heap_size();
+{'\t'}a_0->v__5ftotalCommittedBytes = t_engine::f_resident_memory();
+{'\t'}a_0->v__5ffinalizationPendingCount = f_engine()->v_finalizer__pending;
+{'\t'}a_0->v__5fconcurrent = true;
 ", 0)
             );
-            // TODO
             code.For(
                 type.GetMethod(nameof(GC.GetTotalAllocatedBytes)),
-                transpiler => ("\tthrow std::runtime_error(\"NotImplementedException \" + IL2CXX__AT());\n", 0)
+                transpiler => ("\treturn f_engine()->f_allocated(a_0);\n", 1)
+            );
+            code.For(
+                type.GetMethod(nameof(GC.GetAllocatedBytesForCurrentThread)),
+                transpiler => ("\treturn t_engine::v_allocated__thread;\n", 1)
             );
         })
         .For(get(typeof(WeakReference)), (type, code) =>
         {
             code.For(
                 type.GetMethod("Create", declaredAndInstance),
-                transpiler => ($"\ta_0->v_m_5fhandle = {transpiler.EscapeForValue(get(typeof(IntPtr)))}{{new t__weak_handle(a_1, a_2)}};\n", 1)
+                transpiler => ($"\ta_0->v_m_5fhandle = {transpiler.EscapeForValue(get(typeof(IntPtr)))}{{t__handles::v_weak.f_allocate(a_1, a_2)}};\n", 1)
             );
             code.For(
                 type.GetMethod("Finalize", declaredAndInstance),
-                transpiler => ("\tdelete static_cast<t__weak_handle*>(a_0->v_m_5fhandle.v__5fvalue);\n", 1)
+                transpiler => ("\tt__handles::v_weak.f_free(static_cast<t__weak_handle*>(a_0->v_m_5fhandle.v__5fvalue));\n", 1)
             );
             code.For(
                 type.GetMethod("IsTrackResurrection", declaredAndInstance),
@@ -615,11 +664,11 @@ namespace IL2CXX
         {
             code.ForGeneric(
                 type.GetMethod("Create", declaredAndInstance),
-                (transpiler, types) => ($"\ta_0->v_m_5fhandle = {transpiler.EscapeForValue(get(typeof(IntPtr)))}{{new t__weak_handle(a_1, a_2)}};\n", 1)
+                (transpiler, types) => ($"\ta_0->v_m_5fhandle = {transpiler.EscapeForValue(get(typeof(IntPtr)))}{{t__handles::v_weak.f_allocate(a_1, a_2)}};\n", 1)
             );
             code.ForGeneric(
                 type.GetMethod("Finalize", declaredAndInstance),
-                (transpiler, types) => ("\tdelete static_cast<t__weak_handle*>(a_0->v_m_5fhandle.v__5fvalue);\n", 1)
+                (transpiler, types) => ("\tt__handles::v_weak.f_free(static_cast<t__weak_handle*>(a_0->v_m_5fhandle.v__5fvalue));\n", 1)
             );
             code.ForGeneric(
                 type.GetProperty("Target", declaredAndInstance).GetMethod,
@@ -1014,7 +1063,7 @@ namespace IL2CXX
             );
             code.For(
                 type.GetMethod("GetProcessorCount", BindingFlags.Static | BindingFlags.NonPublic),
-                transpiler => ("\treturn std::thread::hardware_concurrency();\n", 1)
+                transpiler => ("\treturn t_engine::f_processor_count();\n", 1)
             );
             code.For(
                 type.GetProperty(nameof(Environment.HasShutdownStarted)).GetMethod,
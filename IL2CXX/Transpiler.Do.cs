@@ -22,6 +22,12 @@ namespace IL2CXX
         private SortedDictionary<string, (string Prefix, int Index)> definedIndices;
         private bool hasReturn;
         private Dictionary<int, Stack> indexToStack;
+        private Dictionary<int, Flow> indexToFlow;
+        private int estimating;
+        private HashSet<string> spilledVariables;
+        private HashSet<int> initializingStores;
+        private readonly Dictionary<string, int> literals = new();
+        private readonly Dictionary<Type, (long Minimum, long Maximum, int Index)> boxes = new();
         private TextWriter writer;
         private readonly Stack<ExceptionHandlingClause> tries = new();
         private Type constrained;
@@ -156,6 +162,9 @@ inline {returns}
 {{");
             definedIndices = new SortedDictionary<string, (string, int)>();
             indexToStack = new Dictionary<int, Stack>();
+            indexToFlow = new Dictionary<int, Flow>();
+            estimating = -1;
+            spilledVariables = new HashSet<string>();
             log($"{method.DeclaringType}::[{method}]");
             foreach (var x in body.ExceptionHandlingClauses) log($@"{x.Flags}
 {'\t'}try: {x.TryOffset:x04} to {x.TryOffset + x.TryLength:x04}
@@ -171,10 +180,18 @@ inline {returns}
                 switch (x.Flags)
                 {
                     case ExceptionHandlingClauseOptions.Clause:
-                        Estimate(x.HandlerOffset, new Stack(this).Push(x.CatchType));
+                        {
+                            var stack = new Stack(this).Push(x.CatchType);
+                            spilledVariables.Add(stack.Variable);
+                            Estimate(x.HandlerOffset, stack);
+                        }
                         break;
                     case ExceptionHandlingClauseOptions.Filter:
-                        Estimate(x.FilterOffset, new Stack(this).Push(typeofException));
+                        {
+                            var stack = new Stack(this).Push(typeofException);
+                            spilledVariables.Add(stack.Variable);
+                            Estimate(x.FilterOffset, stack);
+                        }
                         break;
                     default:
                         Estimate(x.HandlerOffset, new Stack(this));
@@ -183,12 +200,17 @@ inline {returns}
             writeDeclaration(hasReturn ? string.Empty : "[[noreturn]] ");
             log("\n");
             writer.WriteLine($"\t// init locals: {body.InitLocals}");
+            var spilledLocals = EstimateSpilledLocals(body);
+            initializingStores = EstimateInitializingStores(body);
             foreach (var x in body.LocalVariables)
                 // TODO: uninitialized object references in value types might be copied into heap when compiled with SkipLocalsInit.
-                writer.WriteLine($"\t{EscapeForArgument(x.LocalType)} l{x.LocalIndex}{(body.InitLocals || x.LocalType.IsValueType && Define(x.LocalType).IsManaged ? "{}" : string.Empty)};");
+                writer.WriteLine($"\t{EscapeForStacked(x.LocalType)}{(spilledLocals.Contains(x.LocalIndex) ? " RECYCLONE__SPILL" : string.Empty)} l{x.LocalIndex}{(body.InitLocals || x.LocalType.IsValueType && Define(x.LocalType).IsManaged ? "{}" : string.Empty)};");
             foreach (var x in definedIndices)
                 for (var i = 0; i < x.Value.Index; ++i)
-                    writer.WriteLine($"\t{x.Key} {x.Value.Prefix}{i};");
+                {
+                    var variable = $"{x.Value.Prefix}{i}";
+                    writer.WriteLine($"\t{x.Key}{(spilledVariables.Contains(variable) ? " RECYCLONE__SPILL" : string.Empty)} {variable};");
+                }
             //if (!method.DeclaringType.Name.StartsWith("AllowedBmpCodePointsBitmap")) writer.WriteLine($"\tprintf(\"{Escape(method)}\\n\");");
             if (!inline) writer.WriteLine("\tf_epoch_point();");
             var writers = new Stack<TextWriter>();
@@ -283,6 +305,8 @@ inline {returns}
             Define(typeofRuntimePropertyInfo);
             Define(typeofRuntimeType);
             Escape(finalizeOfObject);
+            var finalizeOfSafeHandle = FinalizeOf(typeofSafeHandle);
+            Enqueue(finalizeOfSafeHandle);
             var typeofThread = getType(typeof(Thread));
             Define(typeofThread);
             Enqueue(getType(typeof(ThreadStart)).GetMethod("Invoke"));
@@ -290,6 +314,7 @@ inline {returns}
             Define(typeofVoid);
             Define(typeofString.MakeArrayType());
             Define(typeofStringBuilder);
+            var throwOutOfMemory = GenerateThrow("OutOfMemory");
             Define(method.DeclaringType);
             Enqueue(method);
             foreach (var x in Bundle) Enqueue(x);
@@ -361,6 +386,8 @@ static t__type* v__exported_{name}[] = {{
 struct t_static
 {");
             writerForDeclarations.Write(staticMembers);
+            if (literals.Count > 0) writerForDeclarations.WriteLine($"\t{EscapeForRoot(typeofString)} v__literals[{literals.Count}]{{}};");
+            foreach (var (t, (minimum, maximum, index)) in boxes) writerForDeclarations.WriteLine($"\tt_root<t_slot_of<{Escape(t)}>> v__boxes_{index}[{maximum - minimum + 1}]{{}};");
             writerForDeclarations.WriteLine($@"
 {'\t'}static t_static* v_instance;
 {'\t'}t_static()
@@ -389,6 +416,18 @@ struct t_thread_static
 }};
 ");
             writerForDeclarations.WriteLine(fieldDeclarations);
+            if (literals.Count > 0) writerForDeclarations.WriteLine($@"// String literals are allocated on first use and shared, falling back to a fresh copy outside the lifetime of t_static.
+inline {EscapeForStacked(typeofString)} f__literal(size_t a_index, std::u16string_view a_value)
+{{
+{'\t'}auto p = t_static::v_instance;
+{'\t'}if (!p) return f__new_string(a_value);
+{'\t'}auto& literal = p->v__literals[a_index];
+{'\t'}if ({Escape(typeofString)}* q = literal) return q;
+{'\t'}auto q = f__new_string(a_value);
+{'\t'}{Escape(typeofString)}* expected = nullptr;
+{'\t'}return literal.f_compare_exchange(expected, q) ? q : expected;
+}}
+");
             writerForDeclarations.WriteLine('}');
             writerForDefinitions.WriteLine($@"namespace il2cxx
 {{
@@ -453,7 +492,13 @@ void f__finalize(t_object<t__type>* a_p)
 {{
 {'\t'}try {{
 {'\t'}{'\t'}try {{
-{'\t'}{'\t'}{'\t'}{GenerateVirtualCall(finalizeOfObject, "a_p", Enumerable.Empty<string>(), x => x)};
+{'\t'}{'\t'}{'\t'}t__trace::f_measure(t__trace_kind::e_finalize, 0, [&]
+{'\t'}{'\t'}{'\t'}{{
+{'\t'}{'\t'}{'\t'}{'\t'}if (a_p->f_type()->v__safe_handle)
+{'\t'}{'\t'}{'\t'}{'\t'}{'\t'}{Escape(finalizeOfSafeHandle)}(static_cast<{Escape(typeofSafeHandle)}*>(a_p));
+{'\t'}{'\t'}{'\t'}{'\t'}else
+{'\t'}{'\t'}{'\t'}{'\t'}{'\t'}{GenerateVirtualCall(finalizeOfObject, "a_p", Enumerable.Empty<string>(), x => x)};
+{'\t'}{'\t'}{'\t'}}});
 {'\t'}{'\t'}}} catch (t__object* p) {{
 {'\t'}{'\t'}{'\t'}throw std::runtime_error(f__string(f__to_string(p)));
 {'\t'}{'\t'}}}
@@ -470,6 +515,13 @@ void f__startup(void* a_bottom)
 {'\t'}auto options = new t_engine::t_options;
 {'\t'}options->v_verbose = std::getenv(""IL2CXX_VERBOSE"");
 {'\t'}options->v_verify = std::getenv(""IL2CXX_VERIFY_LEAKS"");
+{'\t'}t__trace::f_initialize(std::getenv(""IL2CXX_TRACE""));
+{'\t'}t__census::f_initialize(std::getenv(""IL2CXX_CENSUS""), v__name_to_type);
+{'\t'}t__sampler::f_initialize(std::getenv(""IL2CXX_ALLOCATION_PROFILE""), std::getenv(""IL2CXX_ALLOCATION_SAMPLE""));
+{'\t'}t_engine::v_out_of_memory = []
+{'\t'}{{
+{'\t'}{'\t'}{throwOutOfMemory};
+{'\t'}}};
 {'\t'}t_slot thread((new t_engine(*options, a_bottom))->f_initialize<{Escape(typeofThread)}, t_thread_static>(f__finalize));
 {'\t'}new t_static;
 {'\t'}new t_thread_static;
@@ -490,6 +542,13 @@ int main(int argc, char* argv[])
 {'\t'}il2cxx::t_engine::t_options options;
 {'\t'}options.v_verbose = std::getenv(""IL2CXX_VERBOSE"");
 {'\t'}options.v_verify = std::getenv(""IL2CXX_VERIFY_LEAKS"");
+{'\t'}t__trace::f_initialize(std::getenv(""IL2CXX_TRACE""));
+{'\t'}t__census::f_initialize(std::getenv(""IL2CXX_CENSUS""), v__name_to_type);
+{'\t'}t__sampler::f_initialize(std::getenv(""IL2CXX_ALLOCATION_PROFILE""), std::getenv(""IL2CXX_ALLOCATION_SAMPLE""));
+{'\t'}t_engine::v_out_of_memory = []
+{'\t'}{{
+{'\t'}{'\t'}{throwOutOfMemory};
+{'\t'}}};
 {'\t'}il2cxx::t_engine engine(options);
 {'\t'}return [&]() RECYCLONE__NOINLINE
 {'\t'}{{
@@ -133,6 +133,9 @@ namespace IL2CXX
                 [("int64_t", "int64_t")] = typeofInt64,
                 [("void*", "int32_t")] = typeofVoidPointer,
                 [("void*", "void*")] = typeofVoidPointer,
+                [("float", "float")] = typeofSingle,
+                [("float", "double")] = typeofDouble,
+                [("double", "float")] = typeofDouble,
                 [("double", "double")] = typeofDouble
             };
             typeOfDiv_Un = new Dictionary<(string, string), Type>
@@ -231,7 +234,7 @@ namespace IL2CXX
                 x.Estimate = (index, stack) =>
                 {
                     var i = ParseU1(ref index);
-                    return (index, stack.Push(MakePointerType(GetArgumentType(i))));
+                    return (index, stack.Push(MakePointerType(GetArgumentType(i)), true));
                 };
                 x.Generate = (index, stack) =>
                 {
@@ -270,7 +273,7 @@ namespace IL2CXX
                 {
                     var i = ParseU1(ref index);
                     var type = method.GetMethodBody().LocalVariables[i].LocalType;
-                    return (index, stack.Push(MakePointerType(type)));
+                    return (index, stack.Push(MakePointerType(type), true));
                 };
                 x.Generate = (index, stack) =>
                 {
@@ -468,7 +471,7 @@ namespace IL2CXX
                     return index;
                 };
             });
-            string condition_Un(Stack stack, string @operator) => stack.VariableType == "double"
+            string condition_Un(Stack stack, string @operator) => stack.IsFloatingPoint
                 ? string.Format("{0} {1} {2} || std::isunordered({0}, {2})", stack.Pop.Variable, @operator, stack.Variable)
                 : $"{stack.Pop.AsUnsigned} {@operator} {stack.AsUnsigned}";
             string @goto(int index, int target) => target < index ? $@"{{
@@ -622,7 +625,7 @@ namespace IL2CXX
                 x.Generate = (index, stack) =>
                 {
                     writer.WriteLine();
-                    withVolatile(() => writer.WriteLine($"\tf__store(*static_cast<{EscapeForValue(typeofObject)}*>({stack.Pop.Variable}), {stack.Variable});"));
+                    withVolatile(() => writer.WriteLine(GenerateStore(stack.Pop), $"*static_cast<{EscapeForValue(typeofObject)}*>({stack.Pop.Variable})", stack.Variable));
                     return index;
                 };
             });
@@ -686,7 +689,7 @@ namespace IL2CXX
                 x.Generate = (index, stack) =>
                 {
                     var after = indexToStack[index];
-                    var result = set.OpCode == OpCodes.Rem && after.VariableType == "double"
+                    var result = set.OpCode == OpCodes.Rem && after.IsFloatingPoint
                         ? $"std::fmod({stack.Pop.Variable}, {stack.Variable})"
                         : $"{stack.Pop.AsSigned} {set.Operator} {stack.AsSigned}";
                     writer.WriteLine($"\n\t{after.Assign(result)};");
@@ -809,6 +812,10 @@ namespace IL2CXX
                                     generateValueMethod(nameof(RuntimeType.ValueGetHashCode));
                                 else if (cm == typeofValueType.GetMethod(nameof(ToString)))
                                     generateValueMethod(nameof(RuntimeType.ValueToString));
+                                else if (constrained.IsEnum && cm == constrained.BaseType.GetMethod(nameof(Equals)))
+                                    generateValueMethod(nameof(RuntimeType.ValueEquals));
+                                else if (constrained.IsEnum && cm == constrained.BaseType.GetMethod(nameof(GetHashCode)))
+                                    writer.WriteLine($"\t{after.Variable} = *static_cast<std::make_unsigned_t<{primitives[constrained.GetEnumUnderlyingType()]}>*>({@this.Variable});");
                                 else
                                     writer.WriteLine($@"{'\t'}{{auto p = f__new_constructed<{Escape(constrained)}>(*{CastValue(MakePointerType(constrained), @this.Variable)});
 {(isConcrete ? generate(m) : generateVirtual("p"))}{'\t'}}}");
@@ -849,9 +856,12 @@ namespace IL2CXX
                 x.Generate = (index, stack) =>
                 {
                     var s = ParseString(ref index);
-                    writer.Write($"\n\t{indexToStack[index].Variable} = ");
-                    WriteNewString(writer, s);
-                    writer.WriteLine(';');
+                    if (!literals.TryGetValue(s, out var i))
+                    {
+                        i = literals.Count;
+                        literals.Add(s, i);
+                    }
+                    writer.WriteLine($"\n\t{indexToStack[index].Variable} = f__literal({i}, {ToLiteral(s)}sv);");
                     return index;
                 };
             });
@@ -923,7 +933,7 @@ namespace IL2CXX
                 x.Estimate = (index, stack) =>
                 {
                     var t = ParseType(ref index);
-                    return (index, stack.Pop.Push(MakeByRefType(t)));
+                    return (index, stack.Pop.Push(MakeByRefType(t), false));
                 };
                 x.Generate = (index, stack) =>
                 {
@@ -975,7 +985,8 @@ namespace IL2CXX
                 x.Estimate = (index, stack) =>
                 {
                     var f = ParseField(ref index);
-                    return (index, stack.Pop.Push(MakePointerType(f.FieldType)));
+                    var type = MakePointerType(f.FieldType);
+                    return (index, stack.Type.IsByRef || stack.Type.IsPointer ? stack.Pop.Push(type, stack) : stack.Pop.Push(type, stack.Type.IsValueType));
                 };
                 x.Generate = (index, stack) =>
                 {
@@ -996,6 +1007,7 @@ namespace IL2CXX
                 x.Estimate = (index, stack) => (index + 4, stack.Pop.Pop);
                 x.Generate = (index, stack) =>
                 {
+                    var initializing = initializingStores.Contains(index - 1);
                     var f = ParseField(ref index);
                     writer.WriteLine($" {f.DeclaringType}::[{f}]");
                     withVolatile(() =>
@@ -1003,7 +1015,8 @@ namespace IL2CXX
                         GenerateCheckNull(stack.Pop);
                         writer.WriteLine(
                             f.DeclaringType.IsByRefLike ? "\tf__copy({0}, {1});" :
-                            f.DeclaringType.IsValueType && Define(f.FieldType).IsManaged ? "\tf__store({0}, {1});" :
+                            initializing ? "\tf__initialize({0}, {1});" :
+                            f.DeclaringType.IsValueType && Define(f.FieldType).IsManaged ? GenerateStore(stack.Pop) :
                             "\t{0} = {1};",
                             $"static_cast<{Escape(f.DeclaringType)}{(f.DeclaringType.IsValueType ? "::t_value" : string.Empty)}*>({stack.Pop.Variable})->{Escape(f)}",
                             CastValue(f.FieldType, stack.Variable)
@@ -1035,7 +1048,7 @@ namespace IL2CXX
                 x.Estimate = (index, stack) =>
                 {
                     var f = ParseField(ref index);
-                    return (index, stack.Push(MakePointerType(f.FieldType)));
+                    return (index, stack.Push(MakePointerType(f.FieldType), false));
                 };
                 x.Generate = (index, stack) =>
                 {
@@ -1068,7 +1081,7 @@ namespace IL2CXX
                     writer.WriteLine($" {t}");
                     withVolatile(() => writer.WriteLine(
                         t.IsByRefLike ? "\tf__copy({0}, {1});" :
-                        Define(t).IsManaged ? "\tf__store({0}, {1});" :
+                        Define(t).IsManaged ? GenerateStore(stack.Pop) :
                         "\t{0} = {1};",
                         $"*static_cast<{EscapeForValue(t)}*>({stack.Pop.Variable})",
                         CastValue(t, stack.Variable)
@@ -1117,7 +1130,29 @@ namespace IL2CXX
                     else if (GetNullableUnderlyingType(t) is Type u)
                         writer.WriteLine($"\t{after.Variable} = {stack.Variable}.v_hasValue ? f__new_constructed<{Escape(u)}>(const_cast<std::remove_volatile_t<decltype({stack.Variable})>&>({stack.Variable}).v_value) : nullptr;");
                     else if (t.IsValueType)
-                        writer.WriteLine($"\t{after.Variable} = f__new_constructed<{Escape(t)}>(const_cast<std::remove_volatile_t<decltype({stack.Variable})>&>({stack.Variable}));");
+                    {
+                        var @new = $"f__new_constructed<{Escape(t)}>(const_cast<std::remove_volatile_t<decltype({stack.Variable})>&>({stack.Variable}))";
+                        if (!boxes.TryGetValue(t, out var cache) && GetBoxRange(t) is { } range) boxes.Add(t, cache = (range.Minimum, range.Maximum, boxes.Count));
+                        if (boxes.ContainsKey(t))
+                        {
+                            if (t == typeofBoolean)
+                            {
+                                writer.WriteLine($"\t{after.Variable} = t_static::v_instance ? f__box(t_static::v_instance->v__boxes_{cache.Index} + ({stack.Variable} != 0), {stack.Variable} != 0) : {@new};");
+                            }
+                            else
+                            {
+                                // Unsigned values are held in signed variables, so they are widened as unsigned, and both bounds are checked at once by the wrapping offset.
+                                var underlying = t.IsEnum ? t.GetEnumUnderlyingType() : t;
+                                var unsigned = underlying == typeofByte || underlying == typeofUInt16 || underlying == typeofUInt32 || underlying == typeofUInt64 || underlying == typeofChar;
+                                var offset = $"(static_cast<uint64_t>({(unsigned ? stack.AsUnsigned : stack.Variable)}) - static_cast<uint64_t>({cache.Minimum}ll))";
+                                writer.WriteLine($"\t{after.Variable} = t_static::v_instance && {offset} <= {cache.Maximum - cache.Minimum}u ? f__box(t_static::v_instance->v__boxes_{cache.Index} + {offset}, {stack.Variable}) : {@new};");
+                            }
+                        }
+                        else
+                        {
+                            writer.WriteLine($"\t{after.Variable} = {@new};");
+                        }
+                    }
                     return index;
                 };
             });
@@ -1153,7 +1188,7 @@ namespace IL2CXX
                 x.Estimate = (index, stack) =>
                 {
                     var t = ParseType(ref index);
-                    return (index, stack.Pop.Pop.Push(MakePointerType(t)));
+                    return (index, stack.Pop.Pop.Push(MakePointerType(t), false));
                 };
                 x.Generate = (index, stack) =>
                 {
@@ -1583,7 +1618,7 @@ namespace IL2CXX
                     var type = EscapeForValue(t);
                     writer.WriteLine(
                         t.IsByRefLike ? "\tf__store({0}, {1});" :
-                        Define(t).IsManaged ? "\tf__store({0}, {1});" :
+                        Define(t).IsManaged ? GenerateStore(stack) :
                         "\t{0} = {1};",
                         $"*static_cast<{type}*>({stack.Variable})",
                         type.EndsWith("*") ? $"static_cast<{type}>(nullptr)" : $"{type}{{}}"
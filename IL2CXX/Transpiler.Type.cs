@@ -538,7 +538,7 @@ struct t__static_{identifier}
                                 members = $@"{'\t'}t__bound v__bounds[{type.GetArrayRank()}];
 {'\t'}{elementIdentifier}* f_data()
 {'\t'}{{
-{'\t'}{'\t'}return reinterpret_cast<{elementIdentifier}*>(this + 1);
+{'\t'}{'\t'}return f__assume_aligned(reinterpret_cast<{elementIdentifier}*>(this + 1));
 {'\t'}}}
 ";
                                 if (IsComposite(element)) members += $@"{'\t'}void f__scan(t_scan<t__type> a_scan)
@@ -861,6 +861,14 @@ extern t__runtime_method_info* v__generic_methods_{name}[];");
                 } catch { }
             return definition;
         }
+        // A SafeHandle whose Finalize and Dispose(bool) are SafeHandle's own only releases its native handle when finalized.
+        private bool IsPlainSafeHandle(Type type)
+        {
+            if (type.IsAbstract || !typeofSafeHandle.IsAssignableFrom(type)) return false;
+            for (var x = type; x != typeofSafeHandle; x = x.BaseType)
+                if (FinalizeOf(x) != null || x.GetMethod("Dispose", declaredAndInstance, null, new[] { typeofBoolean }, null) != null) return false;
+            return true;
+        }
         private void WriteRuntimeDefinition(RuntimeDefinition definition, string assembly, IReadOnlyDictionary<Type, IEnumerable<Type>> genericTypeDefinitionToConstructeds, TextWriter writerForDeclarations, TextWriter writerForDefinitions)
         {
             writerForDefinitions.Write(definition.Definitions);
@@ -1022,6 +1030,7 @@ t__type_of<{identifier}>::t__type_of() : {@base}(&t__type_of<t__type>::v__instan
 {{");
             writerForDefinitions.WriteLine($@"{'\t'}v__cor_element_type = {GetCorElementType(type)};
 {'\t'}v__type_code = {(int)Type.GetTypeCode(type)};");
+            if (definition is TypeDefinition && IsPlainSafeHandle(type)) writerForDefinitions.WriteLine("\tv__safe_handle = true;");
             if (definition is TypeDefinition) writerForDefinitions.WriteLine($"\tv__managed_size = sizeof({Escape(type)});");
             if (definition.HasUnmanaged)
                 writerForDefinitions.WriteLine($@"{'\t'}v__unmanaged_size = sizeof({Escape(type)}__unmanaged);
@@ -1093,8 +1102,8 @@ t__object* t__type_of<{identifier}>::f_do_clone(const t__object* a_this)
 {'\t'}t__new<{identifier}> q(sizeof({element}) * p->v__length);
 {'\t'}q->v__length = p->v__length;
 {'\t'}std::memcpy(q->v__bounds, p->v__bounds, sizeof(p->v__bounds));
-{'\t'}auto p0 = reinterpret_cast<{element} const*>(p + 1);
-{'\t'}auto p1 = q->f_data();
+{'\t'}{element} const* __restrict p0 = f__assume_aligned(reinterpret_cast<{element} const*>(p + 1));
+{'\t'}{element}* __restrict p1 = q->f_data();
 {'\t'}for (size_t i = 0; i < p->v__length; ++i) new(p1 + i) {element}(p0[i]);
 {'\t'}return q;");
                 }
@@ -27,7 +27,10 @@ namespace IL2CXX
             public readonly Type Type;
             public readonly string VariableType;
             public readonly bool IsPointer;
+            public readonly bool IsSpillable;
             public readonly string Variable;
+            private Stack origin;
+            private bool? onStack;
 
             public Stack(Transpiler transpiler)
             {
@@ -54,7 +57,12 @@ namespace IL2CXX
                         VariableType = "int64_t";
                         prefix = "j";
                     }
-                    else if (Type == transpiler.typeofSingle || Type == transpiler.typeofDouble)
+                    else if (Type == transpiler.typeofSingle)
+                    {
+                        VariableType = "float";
+                        prefix = "s";
+                    }
+                    else if (Type == transpiler.typeofDouble)
                     {
                         VariableType = "double";
                         prefix = "f";
@@ -81,14 +89,16 @@ namespace IL2CXX
                 }
                 else if (!Type.IsValueType)
                 {
-                    VariableType = "t__object* RECYCLONE__SPILL";
+                    VariableType = "t__object*";
                     IsPointer = true;
+                    IsSpillable = true;
                     prefix = "o";
                 }
                 else
                 {
                     var t = transpiler.Escape(Type);
-                    VariableType = $"{t}::t_stacked{(transpiler.ToBeSpilled(Type) ? " RECYCLONE__SPILL" : string.Empty)}";
+                    VariableType = $"{t}::t_stacked";
+                    IsSpillable = transpiler.ToBeSpilled(Type);
                     prefix = $"v{t}__";
                 }
                 Indices.TryGetValue(VariableType, out var index);
@@ -98,11 +108,22 @@ namespace IL2CXX
                 if (index > defined.Index) transpiler.definedIndices[VariableType] = (prefix, index);
             }
             public Stack Push(Type type) => new(this, type);
+            public Stack Push(Type type, bool onStack) => new(this, type) { onStack = onStack };
+            public Stack Push(Type type, Stack origin) => new(this, type) { origin = origin };
+            // Whether a pointer is known to point into the native stack (true) or into the heap (false).
+            public bool? IsOnStack => origin == null ? onStack : origin.IsOnStack;
+            public void Merge(Stack stack)
+            {
+                if (stack == this) return;
+                origin = null;
+                onStack = null;
+            }
             public IEnumerator<Stack> GetEnumerator()
             {
                 for (var x = this; x != null; x = x.Pop) yield return x;
             }
             IEnumerator IEnumerable.GetEnumerator() => GetEnumerator();
+            public bool IsFloatingPoint => VariableType == "float" || VariableType == "double";
             public string AsSigned => IsPointer ? $"reinterpret_cast<intptr_t>({Variable})" : Variable;
             public string AsUnsigned => VariableType switch
             {
@@ -118,6 +139,16 @@ namespace IL2CXX
             public Func<int, Stack, (int, Stack)> Estimate;
             public Func<int, Stack, int> Generate;
         }
+        class Flow
+        {
+            public OpCode OpCode;
+            public readonly List<int> Successors = new();
+            public readonly HashSet<int> Live = new();
+            public bool IsSafepoint;
+            public int Use = -1;
+            public int Define = -1;
+            public int Address = -1;
+        }
 
         private static readonly OpCode[] opcodes1 = new OpCode[256];
         private static readonly OpCode[] opcodes2 = new OpCode[256];
@@ -535,9 +566,49 @@ namespace IL2CXX
             var @return = GetReturnType(method);
             return @return == typeofVoid ? stack : stack.Push(@return);
         }
+        private static readonly HashSet<OpCode> safepoints = new()
+        {
+            OpCodes.Box,
+            OpCodes.Constrained,
+            OpCodes.Cpobj,
+            OpCodes.Initobj,
+            OpCodes.Ldsfld,
+            OpCodes.Ldsflda,
+            OpCodes.Ldstr,
+            OpCodes.Newarr,
+            OpCodes.Stelem,
+            OpCodes.Stelem_Ref,
+            OpCodes.Stfld,
+            OpCodes.Stind_Ref,
+            OpCodes.Stobj,
+            OpCodes.Stsfld
+        };
+        private static bool IsSafepoint(OpCode opcode) => opcode.FlowControl == FlowControl.Call || opcode.FlowControl == FlowControl.Branch || opcode.FlowControl == FlowControl.Cond_Branch || safepoints.Contains(opcode);
+        private Flow NewFlow(OpCode opcode, int index)
+        {
+            var flow = new Flow { OpCode = opcode, IsSafepoint = IsSafepoint(opcode) };
+            int local() => opcode.OperandType switch
+            {
+                OperandType.ShortInlineVar => bytes[index],
+                OperandType.InlineVar => BitConverter.ToUInt16(bytes, index),
+                _ => -1
+            };
+            if (opcode == OpCodes.Ldloc || opcode == OpCodes.Ldloc_S)
+                flow.Use = local();
+            else if (opcode.Value >= OpCodes.Ldloc_0.Value && opcode.Value <= OpCodes.Ldloc_3.Value)
+                flow.Use = opcode.Value - OpCodes.Ldloc_0.Value;
+            else if (opcode == OpCodes.Stloc || opcode == OpCodes.Stloc_S)
+                flow.Define = local();
+            else if (opcode.Value >= OpCodes.Stloc_0.Value && opcode.Value <= OpCodes.Stloc_3.Value)
+                flow.Define = opcode.Value - OpCodes.Stloc_0.Value;
+            else if (opcode == OpCodes.Ldloca || opcode == OpCodes.Ldloca_S)
+                flow.Address = local();
+            return flow;
+        }
         private void Estimate(int index, Stack stack)
         {
             log($"enter {index:x04}");
+            if (estimating >= 0) indexToFlow[estimating].Successors.Add(index);
             while (index < bytes.Length)
             {
                 if (indexToStack.TryGetValue(index, out var x))
@@ -545,18 +616,101 @@ namespace IL2CXX
                     var xs = stack.Select(y => y.VariableType);
                     var ys = x.Select(y => y.VariableType);
                     if (!xs.SequenceEqual(ys)) throw new Exception($"{index:x04}: {string.Join("|", xs)} {string.Join("|", ys)}");
+                    foreach (var (y, z) in x.Zip(stack)) y.Merge(z);
                     break;
                 }
                 indexToStack.Add(index, stack);
                 log($"{index:x04}: ");
+                var start = index;
                 var instruction = instructions1[bytes[index++]];
                 if (instruction.OpCode == OpCodes.Prefix1) instruction = instructions2[bytes[index++]];
                 log($"{instruction.OpCode}");
+                var flow = NewFlow(instruction.OpCode, index);
+                indexToFlow.Add(start, flow);
+                var before = stack;
+                var caller = estimating;
+                estimating = start;
                 (index, stack) = instruction.Estimate?.Invoke(index, stack) ?? throw new Exception($"{instruction.OpCode}");
+                estimating = caller;
+                if (index < int.MaxValue) flow.Successors.Add(index);
+                if (flow.IsSafepoint)
+                {
+                    // Arguments of plain calls are taken over by spilled parameters.
+                    IEnumerable<Stack> live = instruction.OpCode == OpCodes.Call || instruction.OpCode == OpCodes.Callvirt ? stack.Intersect(before) : before;
+                    if (instruction.OpCode == OpCodes.Newobj) live = live.Append(stack);
+                    foreach (var y in live) if (y.IsSpillable) spilledVariables.Add(y.Variable);
+                }
                 log(string.Join(string.Empty, stack.Reverse().Select(y => $"{y.Type}|")));
             }
             log("exit");
         }
+        private HashSet<int> EstimateSpilledLocals(MethodBody body)
+        {
+            var locals = body.LocalVariables.Where(x => ToBeSpilled(x.LocalType)).Select(x => x.LocalIndex).ToHashSet();
+            var successors = indexToFlow.ToDictionary(x => x.Key, x => x.Value.Successors.AsEnumerable());
+            foreach (var clause in body.ExceptionHandlingClauses)
+            {
+                bool guarded(int x) => x >= clause.TryOffset && x < clause.TryOffset + clause.TryLength;
+                var guards = indexToFlow.Keys.Where(guarded).ToList();
+                // Any instruction in a protected range may throw into its handler.
+                var entry = clause.Flags == ExceptionHandlingClauseOptions.Filter ? clause.FilterOffset : clause.HandlerOffset;
+                foreach (var x in guards) successors[x] = successors[x].Append(entry);
+                if (clause.Flags != ExceptionHandlingClauseOptions.Finally) continue;
+                // A finally block resumes wherever the leaves out of its protected range go.
+                var exits = guards.Where(x => indexToFlow[x].OpCode == OpCodes.Leave || indexToFlow[x].OpCode == OpCodes.Leave_S).SelectMany(x => indexToFlow[x].Successors).Where(x => !guarded(x)).ToList();
+                foreach (var (index, flow) in indexToFlow)
+                    if (flow.OpCode == OpCodes.Endfinally && index >= clause.HandlerOffset && index < clause.HandlerOffset + clause.HandlerLength) successors[index] = successors[index].Concat(exits);
+            }
+            var flows = indexToFlow.OrderByDescending(x => x.Key).ToList();
+            for (var changed = true; changed;)
+            {
+                changed = false;
+                foreach (var (index, flow) in flows)
+                {
+                    var n = flow.Live.Count;
+                    foreach (var x in successors[index])
+                    {
+                        var successor = indexToFlow[x];
+                        foreach (var y in successor.Live) if (y != successor.Define) flow.Live.Add(y);
+                        if (successor.Use >= 0) flow.Live.Add(successor.Use);
+                    }
+                    if (flow.Live.Count > n) changed = true;
+                }
+            }
+            var spilled = indexToFlow.Values.Where(x => x.Address >= 0).Select(x => x.Address).ToHashSet();
+            foreach (var x in indexToFlow.Values) if (x.IsSafepoint) spilled.UnionWith(x.Live);
+            spilled.IntersectWith(locals);
+            return spilled;
+        }
+        // Stores into reference fields of `this` in the straight-line prefix of a class constructor.
+        // Nothing has seen the object yet, so each first store overwrites null and needs no decrement.
+        private HashSet<int> EstimateInitializingStores(MethodBody body)
+        {
+            var stores = new HashSet<int>();
+            if (!method.IsConstructor || method.IsStatic || method.DeclaringType.IsValueType) return stores;
+            var targets = indexToFlow.Values.Where(x => x.OpCode.FlowControl != FlowControl.Next).SelectMany(x => x.Successors).ToHashSet();
+            foreach (var x in body.ExceptionHandlingClauses) targets.Add(x.Flags == ExceptionHandlingClauseOptions.Filter ? x.FilterOffset : x.HandlerOffset);
+            var @this = new HashSet<Stack>();
+            var fields = new HashSet<FieldInfo>();
+            foreach (var (start, flow) in indexToFlow.OrderBy(x => x.Key))
+            {
+                if (targets.Contains(start) || flow.OpCode.FlowControl != FlowControl.Next) break;
+                var before = indexToStack[start];
+                var after = indexToStack[flow.Successors[0]];
+                if (flow.OpCode == OpCodes.Stfld)
+                {
+                    if (@this.Contains(before)) break;
+                    if (!@this.Contains(before.Pop)) continue;
+                    var index = start + 1;
+                    var f = ParseField(ref index);
+                    if (!f.FieldType.IsValueType && !f.FieldType.IsPointer && !f.DeclaringType.IsExplicitLayout && fields.Add(f)) stores.Add(start);
+                    continue;
+                }
+                if (before.Except(after).Any(@this.Contains)) break;
+                if (flow.OpCode == OpCodes.Ldarg_0 || flow.OpCode == OpCodes.Dup && @this.Contains(before)) @this.Add(after);
+            }
+            return stores;
+        }
         private static readonly HashSet<string> invalids = new()
         {
             "System.RuntimeType",
@@ -679,6 +833,12 @@ namespace IL2CXX
             writer.Write(GenerateCheckRange(index.AsUnsigned, "p->v__length"));
             writer.WriteLine($"\t{access($"p->f_data()[{index.AsUnsigned}]")};}}");
         }
+        private static string GenerateStore(Stack target) => target.IsOnStack switch
+        {
+            true => "\tf__copy({0}, {1});",
+            false => "\tf__assign({0}, {1});",
+            _ => "\tf__store({0}, {1});"
+        };
         public string CastValue(Type type, string variable) =>
             type == typeofBoolean ? $"{variable} != 0" :
             type.IsPrimitive || type == typeofVoidPointer ? variable :
@@ -944,6 +1104,29 @@ namespace IL2CXX
             WriteLiteral(writer, value);
             writer.Write("sv)");
         }
+        private (long Minimum, long Maximum)? GetBoxRange(Type type)
+        {
+            if (type == typeofBoolean) return (0, 1);
+            var underlying = type.IsEnum ? type.GetEnumUnderlyingType() : type;
+            (long, long) range;
+            if (underlying == typeofSByte)
+                range = (sbyte.MinValue, sbyte.MaxValue);
+            else if (underlying == typeofByte)
+                range = (byte.MinValue, byte.MaxValue);
+            else if (underlying == typeofInt16 || underlying == typeofInt32 || underlying == typeofInt64)
+                range = (-128, 1023);
+            else if (underlying == typeofUInt16 || underlying == typeofUInt32 || underlying == typeofUInt64 || underlying == typeofChar)
+                range = (0, 1023);
+            else
+                return null;
+            if (!type.IsEnum) return range;
+            var values = type.GetFields(BindingFlags.Static | BindingFlags.Public).Select(x => x.GetRawConstantValue() switch
+            {
+                ulong y => y > long.MaxValue ? long.MaxValue : (long)y,
+                var y => Convert.ToInt64(y)
+            }).Where(x => x >= range.Item1 && x <= range.Item2).ToList();
+            return values.Count > 0 ? (values.Min(), values.Max()) : null;
+        }
         private static string ToLiteral(string value)
         {
             if (value == null) return "nullptr";
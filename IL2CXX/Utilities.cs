@@ -37,6 +37,8 @@ namespace IL2CXX
         [MethodImpl(MethodImplOptions.NoInlining)]
         public static void ThrowNotSupported() => throw new NotSupportedException();
         [MethodImpl(MethodImplOptions.NoInlining)]
+        public static void ThrowOutOfMemory() => throw new OutOfMemoryException();
+        [MethodImpl(MethodImplOptions.NoInlining)]
         public static void ThrowOverflow() => throw new OverflowException();
         [MethodImpl(MethodImplOptions.NoInlining)]
         public static void ThrowTarget() => throw new TargetException();
@@ -85,6 +85,13 @@ inline RECYCLONE__ALWAYS_INLINE void f__assign(T_field& a_field, T_value&& a_val
 	a_field = std::forward<T_value>(a_value);
 }
 
+// Stores into a slot known to hold null, so only the increment is recorded.
+template<typename T_field, typename T_value>
+inline RECYCLONE__ALWAYS_INLINE void f__initialize(T_field& a_field, T_value&& a_value)
+{
+	new(const_cast<std::remove_volatile_t<T_field>*>(&a_field)) t_slot<t__type>(std::forward<T_value>(a_value));
+}
+
 template<typename T_field, typename T_value>
 inline RECYCLONE__ALWAYS_INLINE void f__store(T_field& a_field, T_value&& a_value)
 {
@@ -111,6 +118,18 @@ inline bool f__compare_exchange(T*& a_target, T*& a_expected, T* a_desired)
 		: reinterpret_cast<t_slot_of<T>&>(a_target).f_compare_exchange(a_expected, a_desired);
 }
 
+// Objects never move, so a mix of the address stays stable for the whole lifetime of the object.
+inline int32_t f__identity_hash(const void* a_p)
+{
+	auto x = static_cast<uint64_t>(reinterpret_cast<uintptr_t>(a_p));
+	x ^= x >> 33;
+	x *= 0xff51afd7ed558ccdull;
+	x ^= x >> 33;
+	x *= 0xc4ceb9fe1a85ec53ull;
+	x ^= x >> 33;
+	return static_cast<int32_t>(x);
+}
+
 template<typename T>
 struct t__finally
 {
@@ -1,9 +1,356 @@
 #include "engine.h"
+#include <fstream>
+#include <limits>
+#include <cctype>
+#include <csignal>
+#include <random>
+#include <cmath>
+#include <sstream>
+#include <thread>
+#if defined(SIGRTMIN) && !defined(__EMSCRIPTEN__)
+#include <semaphore.h>
+#endif
+#ifdef __GLIBC__
+#include <cxxabi.h>
+#include <dlfcn.h>
+#include <execinfo.h>
+#endif
+#ifdef _WIN32
+#include <psapi.h>
+#endif
+#ifdef __linux__
+#include <sched.h>
+#endif
 
 namespace il2cxx
 {
 
 RECYCLONE__THREAD t__thread* t_engine::v_current_thread;
+RECYCLONE__THREAD size_t t_engine::v_allocated__thread;
+RECYCLONE__THREAD size_t t_engine::v_allocated__pending;
+RECYCLONE__THREAD size_t t_engine::v_allocated__limit = 1 << 16;
+RECYCLONE__THREAD ptrdiff_t t__sampler::v_remaining;
+RECYCLONE__THREAD t__sampler::t_sample t__sampler::v_sample;
+RECYCLONE__THREAD bool t__sampler::v_pending;
+
+void t__trace::f_initialize(const char* a_path)
+{
+	if (!a_path || !*a_path) return;
+	v_instance = new t__trace{a_path};
+	t__type::v__released = [](bool a_cyclic)
+	{
+		v_instance->f_released(a_cyclic);
+	};
+	std::atexit([]
+	{
+		v_instance->f_dump();
+	});
+}
+
+void t__census::f_initialize(const char* a_path, const std::map<std::string_view, t__type*>& a_types)
+{
+	if (!a_path || !*a_path) return;
+	v_instance = new t__census{a_path, a_types};
+	t__type::v__census = true;
+#if defined(SIGRTMIN) && !defined(__EMSCRIPTEN__)
+	// Handled instead of waited for, since a host embedding the runtime may run threads that do not block the signal.
+	// The handler only posts the semaphore, which is async-signal-safe, and the census thread does the dump.
+	static sem_t signaled;
+	sem_init(&signaled, 0, 0);
+	struct sigaction action{};
+	action.sa_handler = [](int)
+	{
+		sem_post(&signaled);
+	};
+	sigemptyset(&action.sa_mask);
+	action.sa_flags = SA_RESTART;
+	sigaction(f_signal(), &action, nullptr);
+	std::thread([]
+	{
+		while (true) if (!sem_wait(&signaled)) v_instance->f_dump();
+	}).detach();
+#endif
+}
+
+void t__census::f_dump() const
+{
+	std::vector<std::tuple<size_t, size_t, std::string_view>> rows;
+	for (auto& [name, type] : v_types) {
+		auto died = type->v__census_died.load(std::memory_order_relaxed);
+		auto born = type->v__census_born.load(std::memory_order_relaxed);
+		if (born <= died) continue;
+		auto live = born - died;
+		// Arrays and strings vary in size, so only their counts are known.
+		rows.emplace_back(live, type->v__array || type->v__full_name == u"System.String" ? 0 : live * type->v__managed_size, name);
+	}
+	std::sort(rows.begin(), rows.end(), std::greater());
+	std::lock_guard lock(v_mutex);
+	std::ofstream out(v_path, std::ios::app);
+	out << "# census " << t__trace::f_now() << '\n';
+	for (auto& [live, bytes, name] : rows) out << live << '\t' << bytes << '\t' << name << '\n';
+}
+
+void t__sampler::f_initialize(const char* a_path, const char* a_interval)
+{
+	if (!a_path || !*a_path) return;
+	size_t interval = a_interval ? std::strtoull(a_interval, nullptr, 10) : 0;
+	v_instance = new t__sampler{a_path, interval > 0 ? interval : 512 * 1024};
+	t__type::v__sample = [](t__type* a_type)
+	{
+		if (!v_pending) return;
+		v_pending = false;
+		v_instance->f_add(a_type);
+	};
+	std::atexit([]
+	{
+		v_instance->f_dump();
+	});
+}
+
+size_t t__sampler::f_next()
+{
+	thread_local std::mt19937_64 random{std::random_device{}()};
+	return static_cast<size_t>(std::exponential_distribution<>(1.0 / v_interval)(random)) + 1;
+}
+
+size_t t__sampler::f_count(size_t a_allocated, size_t a_size)
+{
+	if (v_remaining == 0) {
+		v_remaining = f_next();
+	} else if ((v_remaining -= static_cast<ptrdiff_t>(a_allocated)) <= 0) {
+		// A previous sample whose allocation never told its type is kept as unknown.
+		if (v_pending) f_add(nullptr);
+		v_sample.v_size = a_size;
+#ifdef __GLIBC__
+		v_sample.v_frames = backtrace(v_sample.v_stack, V_FRAMES);
+#else
+		v_sample.v_frames = 0;
+#endif
+		v_pending = true;
+		v_remaining = f_next();
+	}
+	return std::min<size_t>(v_remaining, 1 << 16);
+}
+
+void t__sampler::f_add(t__type* a_type)
+{
+	std::vector<void*> stack(v_sample.v_stack, v_sample.v_stack + v_sample.v_frames);
+	std::lock_guard lock(v_mutex);
+	v_stacks[{a_type, std::move(stack)}] += std::max(v_sample.v_size, v_interval);
+}
+
+void t__sampler::f_dump()
+{
+	std::map<void*, std::string> symbols;
+	auto symbolize = [&](void* a_p) -> const std::string&
+	{
+		auto i = symbols.lower_bound(a_p);
+		if (i != symbols.end() && i->first == a_p) return i->second;
+		std::string name;
+#ifdef __GLIBC__
+		Dl_info info;
+		if (dladdr(a_p, &info) && info.dli_sname) {
+			int status;
+			auto demangled = abi::__cxa_demangle(info.dli_sname, nullptr, nullptr, &status);
+			std::string_view s = status == 0 ? demangled : info.dli_sname;
+			s = s.substr(0, s.find('('));
+			if (s.starts_with("il2cxx::")) s.remove_prefix(8);
+			if (s.starts_with("f_t_")) {
+				// Reverse the transpiler's f_t_{type}__{method}: __ separates the parts, and _ followed by two lowercase hex digits stands for an escaped ASCII character.
+				// Wider escapes are left as they are since they cannot be told apart from the characters that follow.
+				auto hex = [](char c)
+				{
+					return c >= '0' && c <= '9' ? c - '0' : c >= 'a' && c <= 'f' ? c - 'a' + 10 : -1;
+				};
+				s.remove_prefix(4);
+				for (size_t j = 0; j < s.size(); ++j) {
+					if (s[j] != '_') {
+						name += s[j];
+					} else if (j + 1 < s.size() && s[j + 1] == '_') {
+						name += "::";
+						++j;
+					} else if (int c = j + 2 < s.size() && hex(s[j + 1]) >= 0 && hex(s[j + 2]) >= 0 ? hex(s[j + 1]) << 4 | hex(s[j + 2]) : -1; c >= 0x20 && c < 0x80 && !std::isalnum(c)) {
+						name += static_cast<char>(c);
+						j += 2;
+					} else {
+						name += s[j];
+					}
+				}
+			} else {
+				name = s;
+			}
+			std::free(demangled);
+		}
+#endif
+		if (name.empty()) {
+			char address[32];
+			std::snprintf(address, sizeof(address), "%p", a_p);
+			name = address;
+		}
+		return symbols.emplace_hint(i, a_p, std::move(name))->second;
+	};
+	std::map<std::string, size_t> stacks;
+	std::lock_guard lock(v_mutex);
+	for (auto& [key, bytes] : v_stacks) {
+		auto& [type, frames] = key;
+		std::string stack;
+		// The innermost frame is the sampler itself.
+		for (size_t i = frames.size(); i > 1; --i) (stack += symbolize(frames[i - 1])) += ';';
+		if (type)
+			for (auto c : type->v__full_name) stack += c < 0x80 ? static_cast<char>(c) : '?';
+		else
+			stack += '?';
+		stacks[stack] += bytes;
+	}
+	std::ofstream out(v_path);
+	for (auto& [stack, bytes] : stacks) out << stack << ' ' << bytes << '\n';
+}
+
+void t__trace::f_push(t__trace_kind a_kind, uint64_t a_value, uint64_t a_duration)
+{
+	v_events[v_next.fetch_add(1, std::memory_order_relaxed) % V_SIZE] = {
+		f_now(),
+		static_cast<uint32_t>(a_kind),
+		static_cast<uint32_t>(std::hash<std::thread::id>{}(std::this_thread::get_id())),
+		a_value,
+		a_duration
+	};
+}
+
+void t__trace::f_dump() const
+{
+	std::ofstream out(v_path, std::ios::binary);
+	auto n = v_next.load(std::memory_order_relaxed);
+	auto i = n > V_SIZE ? n % V_SIZE : 0;
+	out.write(reinterpret_cast<const char*>(v_events + i), (std::min(n, V_SIZE) - i) * sizeof(t_event));
+	if (n > V_SIZE) out.write(reinterpret_cast<const char*>(v_events), i * sizeof(t_event));
+}
+
+#ifdef __linux__
+namespace
+{
+
+std::string f_cgroup_read(const std::string& a_path)
+{
+	std::ifstream in(a_path);
+	std::string s;
+	std::getline(in, s);
+	return s;
+}
+
+// The cgroup v2 directory of this process, or an empty string under cgroup v1.
+std::string f_cgroup_v2()
+{
+	std::ifstream in("/proc/self/cgroup");
+	for (std::string line; std::getline(in, line);)
+		if (line.compare(0, 3, "0::") == 0) return "/sys/fs/cgroup" + line.substr(3);
+	return {};
+}
+
+// Reads a file of the cgroup v2 directory, falling back to the root when the hierarchy is not namespaced.
+std::string f_cgroup_v2_read(const std::string& a_directory, const char* a_name)
+{
+	auto s = f_cgroup_read(a_directory + '/' + a_name);
+	return s.empty() ? f_cgroup_read(std::string("/sys/fs/cgroup/") + a_name) : s;
+}
+
+}
+#endif
+
+size_t t_engine::f_memory_limit()
+{
+	static size_t limit = []() -> size_t
+	{
+#ifdef __linux__
+		auto v2 = f_cgroup_v2();
+		auto s = v2.empty() ? f_cgroup_read("/sys/fs/cgroup/memory/memory.limit_in_bytes") : f_cgroup_v2_read(v2, "memory.max");
+		if (s.empty() || s == "max") return 0;
+		size_t n = std::strtoull(s.c_str(), nullptr, 10);
+		// cgroup v1 reports no limit as a huge page-rounded value.
+		return n < size_t(sysconf(_SC_PHYS_PAGES)) * sysconf(_SC_PAGESIZE) ? n : 0;
+#else
+		return 0;
+#endif
+	}();
+	return limit;
+}
+
+size_t t_engine::f_processor_count()
+{
+	static size_t count = []
+	{
+		if (auto p = std::getenv("IL2CXX_PROCESSOR_COUNT")) if (auto n = std::atoi(p); n > 0) return size_t(n);
+		size_t n = std::max(std::thread::hardware_concurrency(), 1u);
+#ifdef __linux__
+		cpu_set_t set;
+		if (sched_getaffinity(0, sizeof(set), &set) == 0) n = std::min<size_t>(n, std::max(CPU_COUNT(&set), 1));
+		double quota = 0.0;
+		double period = 0.0;
+		auto v2 = f_cgroup_v2();
+		if (v2.empty()) {
+			quota = std::strtod(f_cgroup_read("/sys/fs/cgroup/cpu/cpu.cfs_quota_us").c_str(), nullptr);
+			period = std::strtod(f_cgroup_read("/sys/fs/cgroup/cpu/cpu.cfs_period_us").c_str(), nullptr);
+		} else {
+			std::istringstream in(f_cgroup_v2_read(v2, "cpu.max"));
+			std::string s;
+			if (in >> s >> period && s != "max") quota = std::strtod(s.c_str(), nullptr);
+		}
+		if (quota > 0.0 && period > 0.0) n = std::min(n, std::max(static_cast<size_t>(std::ceil(quota / period)), size_t(1)));
+#endif
+		return n;
+	}();
+	return count;
+}
+
+#ifdef __unix__
+size_t t_engine::f_physical_memory()
+{
+	size_t n = size_t(sysconf(_SC_PHYS_PAGES)) * sysconf(_SC_PAGESIZE);
+	auto limit = f_memory_limit();
+	return limit > 0 ? std::min(n, limit) : n;
+}
+
+size_t t_engine::f_available_memory()
+{
+	size_t n = size_t(sysconf(_SC_AVPHYS_PAGES)) * sysconf(_SC_PAGESIZE);
+	auto limit = f_memory_limit();
+	if (limit <= 0) return n;
+	auto resident = f_resident_memory();
+	return std::min(n, limit > resident ? limit - resident : 0);
+}
+
+size_t t_engine::f_resident_memory()
+{
+	auto fp = std::fopen("/proc/self/statm", "r");
+	if (!fp) return 0;
+	size_t size = 0;
+	size_t resident = 0;
+	if (std::fscanf(fp, "%zu %zu", &size, &resident) != 2) resident = 0;
+	std::fclose(fp);
+	return resident * sysconf(_SC_PAGESIZE);
+}
+#endif
+#ifdef _WIN32
+size_t t_engine::f_physical_memory()
+{
+	MEMORYSTATUSEX status;
+	status.dwLength = sizeof(status);
+	return GlobalMemoryStatusEx(&status) ? status.ullTotalPhys : 0;
+}
+
+size_t t_engine::f_available_memory()
+{
+	MEMORYSTATUSEX status;
+	status.dwLength = sizeof(status);
+	return GlobalMemoryStatusEx(&status) ? status.ullAvailPhys : 0;
+}
+
+size_t t_engine::f_resident_memory()
+{
+	PROCESS_MEMORY_COUNTERS counters;
+	return GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters)) ? counters.WorkingSetSize : 0;
+}
+#endif
 
 void t_engine::f_background__(t__thread* RECYCLONE__SPILL a_thread, bool a_value)
 {
@@ -45,4 +392,311 @@ size_t t_engine::f_load_count() const
 	return n;
 }
 
+size_t t_engine::f_heap_size() const
+{
+	// Each size class reports its rank with its counts, and its blocks take sizeof(t_object<t__type>) << rank bytes.
+	// Whole blocks are counted, so the size is over by at most the rounding up to each size class.
+	size_t n = 0;
+	v_object__heap.f_statistics([&](auto a_rank, auto, auto a_allocated, auto a_freed)
+	{
+		n += (a_allocated - a_freed) * (sizeof(t_object<t__type>) << a_rank);
+	});
+	return n;
+}
+
+void t_engine::f_allocated__register()
+{
+	f_epoch_region([this]
+	{
+		v_allocated__mutex.lock();
+	});
+	std::lock_guard lock(v_allocated__mutex, std::adopt_lock);
+	v_allocated__threads.push_back(&v_allocated__pending);
+}
+
+void t_engine::f_allocated__unregister()
+{
+	f_allocated__flush();
+	f_epoch_region([this]
+	{
+		v_allocated__mutex.lock();
+	});
+	std::lock_guard lock(v_allocated__mutex, std::adopt_lock);
+	v_allocated__threads.erase(std::find(v_allocated__threads.begin(), v_allocated__threads.end(), &v_allocated__pending));
+}
+
+size_t t_engine::f_allocated__precise() const
+{
+	f_epoch_region([this]
+	{
+		v_allocated__mutex.lock();
+	});
+	std::lock_guard lock(v_allocated__mutex, std::adopt_lock);
+	auto n = v_allocated.load(std::memory_order_relaxed);
+	for (auto p : v_allocated__threads) n += std::atomic_ref(*p).load(std::memory_order_relaxed);
+	return n;
+}
+
+void t_engine::f_finalize__dispatch(t_object<t__type>* a_p)
+{
+	auto engine = f_engine();
+	// Releasing a native handle is short, so it is done right here instead of waking a worker.
+	if (a_p->f_type()->v__safe_handle) return engine->v_finalize(a_p);
+	engine->f_epoch_region([engine]
+	{
+		engine->v_finalizer__mutex.lock();
+	});
+	{
+		std::lock_guard lock(engine->v_finalizer__mutex, std::adopt_lock);
+		engine->v_finalizer__queue.emplace_back(static_cast<t__object*>(a_p));
+		t__trace::f_record(t__trace_kind::e_finalizer_queue, ++engine->v_finalizer__pending);
+	}
+	engine->v_finalizer__wake.notify_one();
+}
+
+void t_engine::f_finalizer__run()
+{
+	t__object* RECYCLONE__SPILL p = nullptr;
+	while (true) {
+		f_epoch_region([this]
+		{
+			std::unique_lock lock(v_finalizer__mutex);
+			v_finalizer__wake.wait(lock, [this]
+			{
+				return v_finalizer__quit || !v_finalizer__queue.empty();
+			});
+			lock.release();
+		});
+		{
+			std::lock_guard lock(v_finalizer__mutex, std::adopt_lock);
+			if (v_finalizer__queue.empty()) return;
+			p = v_finalizer__queue.front();
+			v_finalizer__queue.pop_front();
+		}
+		v_finalize(p);
+		p = nullptr;
+		auto n = --v_finalizer__pending;
+		t__trace::f_record(t__trace_kind::e_finalizer_queue, n);
+		if (n > 0) continue;
+		f_epoch_region([this]
+		{
+			v_finalizer__mutex.lock();
+		});
+		{
+			std::lock_guard lock(v_finalizer__mutex, std::adopt_lock);
+		}
+		v_finalizer__done.notify_all();
+	}
+}
+
+void t_engine::f_finalizer__drain()
+{
+	f_epoch_region([this]
+	{
+		v_finalizer__mutex.lock();
+	});
+	{
+		std::lock_guard lock(v_finalizer__mutex, std::adopt_lock);
+		v_finalizer__quit = true;
+	}
+	v_finalizer__wake.notify_all();
+	// Nothing is dispatched any more, so help the workers empty the queue and then wait until all of them have returned.
+	f_finalizer__run();
+	f_epoch_region([this]
+	{
+		std::unique_lock lock(v_finalizer__mutex);
+		v_finalizer__done.wait(lock, [this]
+		{
+			return v_finalizer__workers <= 0;
+		});
+	});
+}
+
+void t_engine::f_finalize__wait()
+{
+	f_finalize();
+	f_epoch_region([this]
+	{
+		std::unique_lock lock(v_finalizer__mutex);
+		v_finalizer__done.wait(lock, [this]
+		{
+			return v_finalizer__pending <= 0;
+		});
+	});
+}
+
+void t_engine::f_memory_limit__initialize()
+{
+	auto limit = f_memory_limit();
+	auto heap_limit = v_heap_limit.load(std::memory_order_relaxed);
+	if (heap_limit > 0 && (limit <= 0 || heap_limit < limit)) limit = heap_limit;
+	if (limit <= 0) {
+		v_memory_limit__next.store(0, std::memory_order_relaxed);
+		return;
+	}
+	auto step = std::max<size_t>(limit / 64, 1 << 20);
+	v_memory_limit__step.store(step, std::memory_order_relaxed);
+	v_memory_limit__next.store(f_allocated(false) + step, std::memory_order_relaxed);
+}
+
+void t_engine::f_memory_limit__check(size_t a_next)
+{
+	if (!v_memory_limit__next.compare_exchange_strong(a_next, f_allocated(false) + v_memory_limit__step.load(std::memory_order_relaxed), std::memory_order_relaxed)) return;
+	auto heap_limit = v_heap_limit.load(std::memory_order_relaxed);
+	size_t heap = heap_limit > 0 ? f_heap_size() : 0;
+	if (heap > heap_limit && !v_no_gc.load(std::memory_order_relaxed)) {
+		f_collect();
+		heap = f_heap_size();
+		if (heap > heap_limit) {
+			if (v_out_of_memory) v_out_of_memory();
+			throw std::bad_alloc();
+		}
+	}
+	// Collect more often as the heap approaches its limit or the process approaches the container's.
+	auto shift = [](size_t a_used, size_t a_limit) -> size_t
+	{
+		return a_limit <= 0 ? 0 : a_used > a_limit / 10 * 9 ? 4 : a_used > a_limit / 4 * 3 ? 2 : 0;
+	};
+	auto limit = f_memory_limit();
+	auto n = std::max(shift(heap, heap_limit), limit > 0 ? shift(f_resident_memory(), limit) : 0);
+	f_epoch_region([this]
+	{
+		v_latency__mutex.lock();
+	});
+	std::lock_guard lock(v_latency__mutex, std::adopt_lock);
+	if (n == v_memory_limit__shift) return;
+	v_memory_limit__shift = n;
+	f_collector__threshold__update();
+}
+
+int32_t t_engine::f_heap_limit__(size_t a_value)
+{
+	// A limit below the current heap would fail the next check right away.
+	if (a_value > 0 && a_value < f_heap_size()) return 1;
+	v_heap_limit.store(a_value, std::memory_order_relaxed);
+	f_memory_limit__initialize();
+	// Without any limit left, nothing checks again to undo the last shift.
+	if (v_memory_limit__next.load(std::memory_order_relaxed) > 0) return 0;
+	f_epoch_region([this]
+	{
+		v_latency__mutex.lock();
+	});
+	std::lock_guard lock(v_latency__mutex, std::adopt_lock);
+	v_memory_limit__shift = 0;
+	f_collector__threshold__update();
+	return 0;
+}
+
+void t_engine::f_memory_pressure__add(size_t a_bytes)
+{
+	auto n = v_memory_pressure.fetch_add(a_bytes, std::memory_order_relaxed) + a_bytes;
+	t__trace::f_record(t__trace_kind::e_memory_pressure, n);
+	if (v_no_gc.load(std::memory_order_relaxed) || v_latency_mode.load(std::memory_order_relaxed) == 2) return;
+	auto triggered = v_memory_pressure__triggered.load(std::memory_order_relaxed);
+	// Require at least 4MB of new pressure and let the step grow with the total so that steady state does not thrash.
+	if (n < triggered + std::max<size_t>(triggered, 1 << 22)) return;
+	if (!v_memory_pressure__triggered.compare_exchange_strong(triggered, n, std::memory_order_relaxed)) return;
+	t__trace::f_record(t__trace_kind::e_tick, v_allocated.load(std::memory_order_relaxed));
+	f_tick();
+}
+
+void t_engine::f_memory_pressure__remove(size_t a_bytes)
+{
+	auto n = v_memory_pressure.load(std::memory_order_relaxed);
+	while (!v_memory_pressure.compare_exchange_weak(n, n - std::min(n, a_bytes), std::memory_order_relaxed));
+	n -= std::min(n, a_bytes);
+	t__trace::f_record(t__trace_kind::e_memory_pressure, n);
+	auto triggered = v_memory_pressure__triggered.load(std::memory_order_relaxed);
+	while (triggered > n && !v_memory_pressure__triggered.compare_exchange_weak(triggered, n, std::memory_order_relaxed));
+}
+
+void t_engine::f_collector__threshold__update()
+{
+	size_t threshold = v_collector__threshold__base;
+	if (v_no_gc.load(std::memory_order_relaxed))
+		threshold = std::numeric_limits<size_t>::max();
+	else
+		switch (v_latency_mode.load(std::memory_order_relaxed)) {
+		case 0:
+			// Batch: fewer and larger cycle collections.
+			threshold *= 4;
+			break;
+		case 2:
+			// LowLatency: defer cycle collection until the mode is left.
+			threshold = std::numeric_limits<size_t>::max();
+			break;
+		case 3:
+			// SustainedLowLatency: shorter and more frequent cycle collections.
+			threshold = std::max<size_t>(threshold / 4, 1);
+			break;
+		}
+	if (threshold != std::numeric_limits<size_t>::max()) threshold = std::max<size_t>(threshold >> v_memory_limit__shift, 1);
+	std::atomic_ref(v_collector__threshold).store(threshold, std::memory_order_relaxed);
+}
+
+int32_t t_engine::f_latency_mode__(int32_t a_value)
+{
+	f_epoch_region([this]
+	{
+		v_latency__mutex.lock();
+	});
+	std::lock_guard lock(v_latency__mutex, std::adopt_lock);
+	if (v_no_gc.load(std::memory_order_relaxed)) return 1;
+	if (a_value != 0 && a_value != 2 && a_value != 3) a_value = 1;
+	v_latency_mode.store(a_value, std::memory_order_relaxed);
+	f_collector__threshold__update();
+	return 0;
+}
+
+int32_t t_engine::f_no_gc__start(size_t a_budget)
+{
+	auto allocated = f_allocated(true);
+	f_epoch_region([this]
+	{
+		v_latency__mutex.lock();
+	});
+	std::lock_guard lock(v_latency__mutex, std::adopt_lock);
+	if (v_no_gc.load(std::memory_order_relaxed)) return 3;
+	v_no_gc__induced.store(false, std::memory_order_relaxed);
+	v_no_gc__exceeded.store(false, std::memory_order_relaxed);
+	v_no_gc__allocated.store(allocated, std::memory_order_relaxed);
+	v_no_gc__budget.store(a_budget, std::memory_order_relaxed);
+	v_no_gc.store(true, std::memory_order_relaxed);
+	f_collector__threshold__update();
+	return 0;
+}
+
+int32_t t_engine::f_no_gc__end()
+{
+	auto allocated = f_allocated(true);
+	f_epoch_region([this]
+	{
+		v_latency__mutex.lock();
+	});
+	std::lock_guard lock(v_latency__mutex, std::adopt_lock);
+	if (!v_no_gc.load(std::memory_order_relaxed)) return v_no_gc__exceeded.exchange(false, std::memory_order_relaxed) ? 3 : 1;
+	v_no_gc.store(false, std::memory_order_relaxed);
+	f_collector__threshold__update();
+	if (v_no_gc__induced.load(std::memory_order_relaxed)) return 2;
+	return allocated - v_no_gc__allocated.load(std::memory_order_relaxed) > v_no_gc__budget.load(std::memory_order_relaxed) ? 3 : 0;
+}
+
+void t_engine::f_no_gc__exceed()
+{
+	// Like .NET, going over the budget leaves the region and collects, so that cycle collection does not stay off for good.
+	f_epoch_region([this]
+	{
+		v_latency__mutex.lock();
+	});
+	{
+		std::lock_guard lock(v_latency__mutex, std::adopt_lock);
+		if (!v_no_gc.load(std::memory_order_relaxed)) return;
+		v_no_gc.store(false, std::memory_order_relaxed);
+		v_no_gc__exceeded.store(true, std::memory_order_relaxed);
+		f_collector__threshold__update();
+	}
+	t__trace::f_record(t__trace_kind::e_tick, v_allocated.load(std::memory_order_relaxed));
+	f_tick();
+}
+
 }
@@ -2,6 +2,12 @@
 #define IL2CXX__ENGINE_H
 
 #include "types.h"
+#include <chrono>
+#include <csignal>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <vector>
 
 namespace il2cxx
 {
@@ -21,14 +27,220 @@ inline auto f_epoch_noiger(T a_do)
 	return recyclone::f_epoch_noiger<t__type>(a_do);
 }
 
+enum class t__trace_kind : uint32_t
+{
+	e_collect,
+	e_finalize_wait,
+	e_finalize,
+	e_allocated,
+	e_memory_pressure,
+	e_finalizer_queue,
+	e_tick,
+	e_released,
+	e_cyclic_released
+};
+
+// A fixed ring of the latest runtime events, enabled by IL2CXX_TRACE and written there at exit.
+struct t__trace
+{
+	static constexpr size_t V_SIZE = 1 << 16;
+	// Releases are recorded with their running total once per this many, so that freeing a large graph does not flush the ring.
+	static constexpr size_t V_RELEASED = 256;
+
+	struct t_event
+	{
+		uint64_t v_time;
+		uint32_t v_kind;
+		uint32_t v_thread;
+		uint64_t v_value;
+		uint64_t v_duration;
+	};
+
+	static inline t__trace* v_instance;
+
+	static uint64_t f_now()
+	{
+		return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+	}
+	static void f_initialize(const char* a_path);
+	static void f_record(t__trace_kind a_kind, uint64_t a_value, uint64_t a_duration = 0)
+	{
+		if (v_instance) [[unlikely]] v_instance->f_push(a_kind, a_value, a_duration);
+	}
+	template<typename T>
+	static void f_measure(t__trace_kind a_kind, uint64_t a_value, T a_do)
+	{
+		if (!v_instance) [[likely]] return a_do();
+		auto t0 = f_now();
+		a_do();
+		v_instance->f_push(a_kind, a_value, f_now() - t0);
+	}
+
+	std::string v_path;
+	std::atomic_size_t v_next = 0;
+	t_event v_events[V_SIZE];
+	std::atomic_size_t v_released[2]{};
+
+	void f_push(t__trace_kind a_kind, uint64_t a_value, uint64_t a_duration);
+	void f_released(bool a_cyclic)
+	{
+		auto n = v_released[a_cyclic].fetch_add(1, std::memory_order_relaxed) + 1;
+		if (n % V_RELEASED == 0) f_push(a_cyclic ? t__trace_kind::e_cyclic_released : t__trace_kind::e_released, n, 0);
+	}
+	void f_dump() const;
+};
+
+// Per-type live object counts, enabled by IL2CXX_CENSUS and appended there on SIGRTMIN+4 and at exit.
+// SIGUSR1 and SIGUSR2 are left alone as recyclone suspends and resumes threads with them in the preemptive mode.
+struct t__census
+{
+	static inline t__census* v_instance;
+
+#ifdef SIGRTMIN
+	static int f_signal()
+	{
+		return SIGRTMIN + 4;
+	}
+#endif
+	static void f_initialize(const char* a_path, const std::map<std::string_view, t__type*>& a_types);
+
+	std::string v_path;
+	const std::map<std::string_view, t__type*>& v_types;
+	mutable std::mutex v_mutex;
+
+	void f_dump() const;
+};
+
+// Samples one allocation per IL2CXX_ALLOCATION_SAMPLE bytes on average and writes collapsed stacks to IL2CXX_ALLOCATION_PROFILE at exit.
+// Frames are named through dladdr, so the executable has to export its symbols (-rdynamic).
+struct t__sampler
+{
+	static constexpr size_t V_FRAMES = 32;
+
+	struct t_sample
+	{
+		size_t v_size;
+		size_t v_frames;
+		void* v_stack[V_FRAMES];
+	};
+
+	static inline t__sampler* v_instance;
+	static RECYCLONE__THREAD ptrdiff_t v_remaining;
+	// The latest sample of this thread waits here until its allocation tells the type.
+	static RECYCLONE__THREAD t_sample v_sample;
+	static RECYCLONE__THREAD bool v_pending;
+
+	static void f_initialize(const char* a_path, const char* a_interval);
+
+	std::string v_path;
+	size_t v_interval;
+	std::mutex v_mutex;
+	// Sampled bytes are summed per type and stack as they come, so that long runs only grow with distinct allocation sites.
+	std::map<std::pair<t__type*, std::vector<void*>>, size_t> v_stacks;
+
+	size_t f_next();
+	size_t f_count(size_t a_allocated, size_t a_size);
+	void f_add(t__type* a_type);
+	void f_dump();
+};
+
 struct t_engine : recyclone::t_engine<t__type>
 {
 	static RECYCLONE__THREAD t__thread* v_current_thread;
+	static RECYCLONE__THREAD size_t v_allocated__thread;
+	static RECYCLONE__THREAD size_t v_allocated__pending;
+	static RECYCLONE__THREAD size_t v_allocated__limit;
+
+	static size_t f_memory_limit();
+	static size_t f_processor_count();
+	static size_t f_physical_memory();
+	static size_t f_available_memory();
+	static size_t f_resident_memory();
+	static inline void (*v_out_of_memory)() = nullptr;
+
+	// Threads publish their allocations in chunks to keep the fast path free of atomics.
+	std::atomic_size_t v_allocated = 0;
+	// The pending bytes of each running thread, which a precise total adds up.
+	mutable std::mutex v_allocated__mutex;
+	std::vector<size_t*> v_allocated__threads;
+	size_t v_collector__threshold__base;
+	// GCSettings and no-GC regions change these on any mutator while allocating threads read them.
+	// The mutex keeps the collector threshold consistent with them.
+	std::mutex v_latency__mutex;
+	std::atomic_int32_t v_latency_mode = 1;
+	std::atomic_bool v_no_gc = false;
+	std::atomic_bool v_no_gc__induced = false;
+	std::atomic_size_t v_no_gc__allocated;
+	std::atomic_size_t v_no_gc__budget;
+	// Set when the region was left for going over its budget, which EndNoGCRegion reports.
+	std::atomic_bool v_no_gc__exceeded = false;
+	// Memory usage is checked each time the allocated bytes pass v_memory_limit__next, which stays zero without any limit.
+	// v_heap_limit bounds the managed heap, while the container's limit bounds the whole process.
+	std::atomic_size_t v_heap_limit = 0;
+	std::atomic_size_t v_memory_limit__step = 0;
+	std::atomic_size_t v_memory_limit__next = 0;
+	// Guarded by v_latency__mutex.
+	size_t v_memory_limit__shift = 0;
+	// Unmanaged memory registered by GC.AddMemoryPressure, which requests a collection each time it grows past its last trigger.
+	std::atomic_size_t v_memory_pressure = 0;
+	std::atomic_size_t v_memory_pressure__triggered = 0;
+	// The engine's finalizer only hands objects over to a pool of v_finalizer__threads workers, which keeps the queue depth known.
+	size_t v_finalizer__threads = 1;
+	void(*v_finalize)(t_object<t__type>*);
+	std::mutex v_finalizer__mutex;
+	std::condition_variable v_finalizer__wake;
+	std::condition_variable v_finalizer__done;
+	std::deque<t_root<t_slot_of<t__object>>> v_finalizer__queue;
+	std::atomic_size_t v_finalizer__pending = 0;
+	bool v_finalizer__quit = false;
+	size_t v_finalizer__workers = 0;
 
 	using recyclone::t_engine<t__type>::t_engine;
-	RECYCLONE__ALWAYS_INLINE constexpr t__object* f_allocate(size_t a_size)
+	decltype(auto) f_exit(int a_code)
+	{
+		// Taken while the statics are still alive.
+		if (t__census::v_instance) t__census::v_instance->f_dump();
+		return recyclone::t_engine<t__type>::f_exit(a_code);
+	}
+	RECYCLONE__ALWAYS_INLINE t__object* f_allocate(size_t a_size)
+	{
+		v_allocated__thread += a_size;
+		// Only this thread writes its pending bytes, so a relaxed load and store are enough for the others to read them.
+		std::atomic_ref pending(v_allocated__pending);
+		auto n = pending.load(std::memory_order_relaxed) + a_size;
+		pending.store(n, std::memory_order_relaxed);
+		if (n >= v_allocated__limit) [[unlikely]] f_allocated__overflow(a_size);
+		auto p = static_cast<t__object*>(recyclone::t_engine<t__type>::f_allocate(a_size));
+		assert(reinterpret_cast<uintptr_t>(p) % v__array_alignment == 0);
+		return p;
+	}
+	void f_allocated__flush()
+	{
+		std::atomic_ref pending(v_allocated__pending);
+		auto n = pending.load(std::memory_order_relaxed);
+		t__trace::f_record(t__trace_kind::e_allocated, n);
+		v_allocated.fetch_add(n, std::memory_order_relaxed);
+		pending.store(0, std::memory_order_relaxed);
+	}
+	void f_allocated__overflow(size_t a_size)
 	{
-		return static_cast<t__object*>(recyclone::t_engine<t__type>::f_allocate(a_size));
+		auto n = v_allocated__pending;
+		f_allocated__flush();
+		if (t__sampler::v_instance) [[unlikely]] v_allocated__limit = t__sampler::v_instance->f_count(n, a_size);
+		if (v_no_gc.load(std::memory_order_relaxed)) [[unlikely]] {
+			auto allocated = v_allocated.load(std::memory_order_relaxed);
+			auto start = v_no_gc__allocated.load(std::memory_order_relaxed);
+			if (allocated > start && allocated - start > v_no_gc__budget.load(std::memory_order_relaxed)) f_no_gc__exceed();
+		}
+		auto next = v_memory_limit__next.load(std::memory_order_relaxed);
+		if (next > 0 && v_allocated.load(std::memory_order_relaxed) >= next) [[unlikely]] f_memory_limit__check(next);
+	}
+	void f_allocated__register();
+	void f_allocated__unregister();
+	size_t f_allocated__precise() const;
+	size_t f_allocated(bool a_precise) const
+	{
+		return a_precise ? f_allocated__precise() : v_allocated.load(std::memory_order_relaxed);
 	}
 	template<typename T>
 	void f_start(t__thread* RECYCLONE__SPILL a_thread, T a_main);
@@ -37,6 +249,21 @@ struct t_engine : recyclone::t_engine<t__type>
 	template<typename T_thread, typename T_thread_static>
 	T_thread* f_initialize(void(*a_finalize)(t_object<t__type>*));
 	size_t f_load_count() const;
+	size_t f_heap_size() const;
+	static void f_finalize__dispatch(t_object<t__type>* a_p);
+	void f_finalizer__run();
+	void f_finalizer__drain();
+	void f_finalize__wait();
+	void f_memory_limit__initialize();
+	void f_memory_limit__check(size_t a_next);
+	int32_t f_heap_limit__(size_t a_value);
+	void f_memory_pressure__add(size_t a_bytes);
+	void f_memory_pressure__remove(size_t a_bytes);
+	void f_collector__threshold__update();
+	int32_t f_latency_mode__(int32_t a_value);
+	int32_t f_no_gc__start(size_t a_budget);
+	int32_t f_no_gc__end();
+	void f_no_gc__exceed();
 };
 
 template<typename T>
@@ -45,10 +272,12 @@ void t_engine::f_start(t__thread* RECYCLONE__SPILL a_thread, T a_main)
 	recyclone::t_engine<t__type>::f_start(a_thread, [a_thread]
 	{
 		a_thread->f_initialize();
-	}, [a_thread, main = std::move(a_main)]
+	}, [this, a_thread, main = std::move(a_main)]
 	{
 		v_current_thread = a_thread;
+		f_allocated__register();
 		main();
+		f_allocated__unregister();
 	});
 }
 
@@ -90,16 +319,47 @@ T* f__new_zerod()
 template<typename T_thread, typename T_thread_static>
 T_thread* t_engine::f_initialize(void(*a_finalize)(t_object<t__type>*))
 {
+	if (auto p = std::getenv("IL2CXX_GC_THRESHOLD")) v_collector__threshold = std::strtoull(p, nullptr, 10);
+	v_collector__threshold__base = v_collector__threshold;
+	if (auto p = std::getenv("IL2CXX_GC_HEAP_HARD_LIMIT")) v_heap_limit.store(std::strtoull(p, nullptr, 10), std::memory_order_relaxed);
+	f_memory_limit__initialize();
+	if (auto p = std::getenv("IL2CXX_GC_LATENCY_MODE")) f_latency_mode__(std::atoi(p));
 	auto RECYCLONE__SPILL thread = f__new_zerod<T_thread>();
 	thread->v_internal = v_thread__main;
 	v_current_thread = thread;
+	f_allocated__register();
+	if (auto p = std::getenv("IL2CXX_FINALIZER_THREADS")) v_finalizer__threads = std::max(std::atoi(p), 1);
+	v_finalize = a_finalize;
 	auto RECYCLONE__SPILL finalizer = f__new_zerod<T_thread>();
-	f_start(finalizer, [this, a_finalize]
+	f_start(finalizer, [this]
 	{
 		auto ts = std::make_unique<T_thread_static>();
-		f_finalizer(a_finalize);
+		f_finalizer(f_finalize__dispatch);
+		f_finalizer__drain();
 	});
 	v_thread__finalizer = finalizer->v_internal;
+	v_finalizer__workers = v_finalizer__threads;
+	for (size_t i = 0; i < v_finalizer__threads; ++i) {
+		auto RECYCLONE__SPILL worker = f__new_zerod<T_thread>();
+		// The engine stops the finalizer thread only after the foreground threads, and the finalizer thread waits for the workers in f_finalizer__drain.
+		worker->v__background = true;
+		f_start(worker, [this]
+		{
+			{
+				auto ts = std::make_unique<T_thread_static>();
+				f_finalizer__run();
+			}
+			f_epoch_region([this]
+			{
+				v_finalizer__mutex.lock();
+			});
+			{
+				std::lock_guard lock(v_finalizer__mutex, std::adopt_lock);
+				--v_finalizer__workers;
+			}
+			v_finalizer__done.notify_all();
+		});
+	}
 	return thread;
 }
 
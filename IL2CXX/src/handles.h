@@ -2,41 +2,176 @@
 #define IL2CXX__OBJECT_H
 
 #include "types.h"
+#include <mutex>
+#include <new>
 
 namespace il2cxx
 {
 
 using namespace recyclone;
 
-struct t__handle
+// Handles live in size-aligned segments so that the kind of a handle is found from its address.
+struct t__handle_segment
 {
-	virtual ~t__handle() = default;
-	virtual t__object* f_target() const = 0;
-	virtual void f_target__(t__object* a_value) = 0;
+	static constexpr size_t V_SIZE = 16384;
+
+	t__handle_segment* v_next;
+	bool v_weak;
 };
 
-struct t__normal_handle : t__handle
+template<typename T, bool A_weak>
+class t__handle_pool
 {
-	t_root<t_slot_of<t__object>> v_target;
+	union t_cell
+	{
+		T v_value;
+		t_cell* v_next;
+
+		t_cell()
+		{
+		}
+		~t_cell()
+		{
+		}
+	};
+	static constexpr size_t V_CELLS = (t__handle_segment::V_SIZE - sizeof(t__handle_segment)) / sizeof(t_cell);
+	static constexpr size_t V_CACHE = 64;
 
-	t__normal_handle(t__object* a_target) : v_target(a_target)
+	struct t_segment : t__handle_segment
+	{
+		t_cell v_cells[V_CELLS];
+	};
+	static_assert(sizeof(t_segment) <= t__handle_segment::V_SIZE);
+	struct t_cache
+	{
+		t__handle_pool* v_pool = nullptr;
+		t_cell* v_head = nullptr;
+		size_t v_size = 0;
+
+		~t_cache()
+		{
+			if (v_pool) v_pool->f_release(*this, 0);
+		}
+	};
+
+	std::mutex v_mutex;
+	t__handle_segment* v_segments = nullptr;
+	t_cell* v_free = nullptr;
+	static inline thread_local t_cache v_cache;
+
+	void f_grow()
+	{
+		auto segment = static_cast<t_segment*>(::operator new(t__handle_segment::V_SIZE, std::align_val_t(t__handle_segment::V_SIZE)));
+		segment->v_next = v_segments;
+		segment->v_weak = A_weak;
+		v_segments = segment;
+		for (auto& x : segment->v_cells) {
+			x.v_next = v_free;
+			v_free = &x;
+		}
+	}
+	void f_acquire(t_cache& a_cache)
+	{
+		std::lock_guard lock(v_mutex);
+		a_cache.v_pool = this;
+		while (a_cache.v_size < V_CACHE / 2) {
+			if (!v_free) f_grow();
+			auto p = v_free;
+			v_free = p->v_next;
+			p->v_next = a_cache.v_head;
+			a_cache.v_head = p;
+			++a_cache.v_size;
+		}
+	}
+	void f_release(t_cache& a_cache, size_t a_keep)
+	{
+		std::lock_guard lock(v_mutex);
+		while (a_cache.v_size > a_keep) {
+			auto p = a_cache.v_head;
+			a_cache.v_head = p->v_next;
+			p->v_next = v_free;
+			v_free = p;
+			--a_cache.v_size;
+		}
+	}
+
+public:
+	template<typename... T_an>
+	T* f_allocate(T_an&&... a_n)
+	{
+		auto& cache = v_cache;
+		if (!cache.v_head) f_acquire(cache);
+		auto p = cache.v_head;
+		cache.v_head = p->v_next;
+		--cache.v_size;
+		return new(&p->v_value) T(std::forward<T_an>(a_n)...);
+	}
+	void f_free(T* a_p)
 	{
+		if (!a_p) return;
+		a_p->~T();
+		auto p = reinterpret_cast<t_cell*>(a_p);
+		auto& cache = v_cache;
+		// A thread may only free handles allocated by others, and its cache still has to be returned at exit.
+		cache.v_pool = this;
+		p->v_next = cache.v_head;
+		cache.v_head = p;
+		if (++cache.v_size >= V_CACHE) f_release(cache, V_CACHE / 2);
 	}
-	virtual t__object* f_target() const;
-	virtual void f_target__(t__object* a_value);
 };
 
-struct t__weak_handle : t__handle, t_weak_pointer<t__type>
+struct t__weak_handle : t_weak_pointer<t__type>
 {
 	t__weak_handle(t__object* a_target, bool a_final) : t_weak_pointer<t__type>(a_target, a_final)
 	{
 	}
-	virtual t__object* f_target() const;
-	virtual void f_target__(t__object* a_value);
+	t__object* f_target() const
+	{
+		return static_cast<t__object*>(f_get().first);
+	}
 };
 
+using t__normal_handle = t_root<t_slot_of<t__object>>;
+// The dependent is kept alive only while the target is, which gives ConditionalWeakTable its ephemeron semantics.
 using t__dependent_handle = t_weak_pointer<t__type>;
 
+struct t__handles
+{
+	static t__handle_pool<t__normal_handle, false> v_normal;
+	static t__handle_pool<t__weak_handle, true> v_weak;
+	static t__handle_pool<t__dependent_handle, true> v_dependent;
+
+	static bool f_weak(void* a_handle)
+	{
+		return reinterpret_cast<t__handle_segment*>(reinterpret_cast<uintptr_t>(a_handle) & ~(t__handle_segment::V_SIZE - 1))->v_weak;
+	}
+	static void* f_allocate(t__object* a_target, int32_t a_type)
+	{
+		if (a_type < 2) return v_weak.f_allocate(a_target, a_type > 0);
+		return v_normal.f_allocate(a_target);
+	}
+	static void f_free(void* a_handle)
+	{
+		if (f_weak(a_handle))
+			v_weak.f_free(static_cast<t__weak_handle*>(a_handle));
+		else
+			v_normal.f_free(static_cast<t__normal_handle*>(a_handle));
+	}
+	static t__object* f_target(void* a_handle)
+	{
+		if (f_weak(a_handle)) return static_cast<t__weak_handle*>(a_handle)->f_target();
+		return *static_cast<t__normal_handle*>(a_handle);
+	}
+	static void f_target__(void* a_handle, t__object* a_value)
+	{
+		if (f_weak(a_handle))
+			static_cast<t__weak_handle*>(a_handle)->f_target__(a_value);
+		else
+			*static_cast<t__normal_handle*>(a_handle) = a_value;
+	}
+};
+
+
 }
 
 #endif
@@ -50,7 +50,9 @@ void t__type::f_do_suppress_finalize(t__object* a_this)
 
 void t__type::f_do_clear(void* a_p, size_t a_n)
 {
-	std::fill_n(static_cast<t_slot<t__type>*>(a_p), a_n, nullptr);
+	auto p = static_cast<t_slot<t__type>*>(a_p);
+	auto q = static_cast<t__object* const*>(a_p);
+	for (size_t i = 0; i < a_n; ++i) if (q[i]) p[i] = nullptr;
 }
 
 void t__type::f_do_clear_pointer(void* a_p, size_t a_n)
@@ -60,7 +62,19 @@ void t__type::f_do_clear_pointer(void* a_p, size_t a_n)
 
 void t__type::f_do_copy(const void* a_from, size_t a_n, void* a_to)
 {
-	f__copy(static_cast<const t_slot<t__type>*>(a_from), a_n, static_cast<t_slot<t__type>*>(a_to));
+	auto from = static_cast<t__object* const*>(a_from);
+	auto to = static_cast<t__object**>(a_to);
+	// Every store goes through the slot's exchange even when the slots overlap, since other threads may store into the same slots at the same time.
+	// Only stores that would not change the slot are skipped.
+	auto copy = [&](size_t i)
+	{
+		auto p = from[i];
+		if (to[i] != p) reinterpret_cast<t_slot<t__type>&>(to[i]) = p;
+	};
+	if (to > from && to < from + a_n)
+		for (size_t i = a_n; i > 0;) copy(--i);
+	else
+		for (size_t i = 0; i < a_n; ++i) copy(i);
 }
 
 void t__type::f_do_copy_pointer(const void* a_from, size_t a_n, void* a_to)
@@ -186,6 +200,7 @@ t__object* t__type::f_new_zerod()
 	auto RECYCLONE__SPILL p = f_engine()->f_allocate(v__managed_size);
 	std::memset(p + 1, 0, v__managed_size - sizeof(t__object));
 	f_register_finalize(p);
+	f_born();
 	p->f_be(this);
 	return p;
 }
@@ -216,11 +216,18 @@ struct t__type : t__abstract_type
 	uint8_t v__by_ref_like : 1;
 	uint8_t v__cor_element_type;
 	uint8_t v__type_code;
+	// Set by the transpiler for SafeHandles finalized only by SafeHandle's own release, which the finalizer calls directly.
+	bool v__safe_handle = false;
 	size_t v__size;
 	size_t v__managed_size = 0;
 	size_t v__unmanaged_size = 0;
 	size_t v__slots;
 	t__type* v__szarray;
+	static inline bool v__census = false;
+	static inline void (*v__sample)(t__type*) = nullptr;
+	static inline void (*v__released)(bool) = nullptr;
+	std::atomic_size_t v__census_born = 0;
+	std::atomic_size_t v__census_died = 0;
 	union
 	{
 		struct
@@ -270,17 +277,28 @@ struct t__type : t__abstract_type
 	void f_push()
 	{
 	}
+	// Called once for each object of this type released by reference counting or by cycle collection.
 	void f_decrement_push()
 	{
+		if (v__census) [[unlikely]] v__census_died.fetch_add(1, std::memory_order_relaxed);
+		if (v__released) [[unlikely]] v__released(false);
 	}
 	void f_cyclic_decrement_push()
 	{
+		if (v__census) [[unlikely]] v__census_died.fetch_add(1, std::memory_order_relaxed);
+		if (v__released) [[unlikely]] v__released(true);
 	}
 	void f_own()
 	{
 	}
+	RECYCLONE__ALWAYS_INLINE void f_born()
+	{
+		if (v__census) [[unlikely]] v__census_born.fetch_add(1, std::memory_order_relaxed);
+		if (v__sample) [[unlikely]] v__sample(this);
+	}
 	RECYCLONE__ALWAYS_INLINE void f_finish(t_object<t__type>* RECYCLONE__SPILL a_p)
 	{
+		f_born();
 		a_p->f_be(this);
 	}
 	static void f_do_scan(t_object<t__type>* a_this, t_scan<t__type> a_scan);
@@ -563,6 +581,20 @@ inline T1 f__copy(T0 a_in, size_t a_n, T1 a_out)
 	return a_in < a_out ? std::copy_backward(a_in, a_in + a_n, a_out + a_n) : std::copy_n(a_in, a_n, a_out);
 }
 
+// Array payloads start at this boundary: the array header and every bound are padded to it.
+// This relies on the heap handing out blocks aligned to it, which t_engine::f_allocate asserts.
+constexpr size_t v__array_alignment = 16;
+
+template<typename T>
+inline RECYCLONE__ALWAYS_INLINE T* f__assume_aligned(T* a_p)
+{
+#ifdef _MSC_VER
+	return a_p;
+#else
+	return static_cast<T*>(__builtin_assume_aligned(a_p, v__array_alignment));
+#endif
+}
+
 }
 
 #endif
@@ -6,6 +6,16 @@ T* f__new_constructed(T_an&&... a_n)
 	return p;
 }
 
+// Boxes have no identity, so a box of a small value is allocated once into its cache slot and shared.
+template<typename T, typename T_value>
+T* f__box(t_root<t_slot_of<T>>* a_cache, const T_value& a_value)
+{
+	if (T* p = *a_cache) return p;
+	T* p = f__new_constructed<T>(a_value);
+	T* expected = nullptr;
+	return a_cache->f_compare_exchange(expected, p) ? p : expected;
+}
+
 template<typename T_array, typename T_element>
 T_array* f__new_array(size_t a_length)
 {